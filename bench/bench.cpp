@@ -0,0 +1,400 @@
+// bench/bench.cpp
+// Microbenchmarks of the schedsim hot paths (the `bench` build target):
+//   scheduler-bench [min=N] [max=N] [reps=R] [warmup=W] [policies=rr,pps,..]
+//   scheduler-bench pps [reps] [FILE]   PPS backends on one process list
+//                                       (FILE or stdin)
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "schedsim/schedsim.hpp"
+
+using namespace std;
+using namespace schedsim;
+
+// Baseline for the benchmark: the PPS heap as it was before the process
+// table, holding indices and comparing by chasing three fields of the
+// array-of-structs process list.
+struct ProcessHeapScheduler : Scheduler {
+    struct Cmp {
+        const vector<Process>* procs;
+        bool operator()(int a, int b) const {
+            const Process &x = (*procs)[a], &y = (*procs)[b];
+            if(x.priority != y.priority) return x.priority > y.priority;
+            if(x.arrival != y.arrival) return x.arrival > y.arrival;
+            return x.pid > y.pid;
+        }
+    };
+    priority_queue<int, vector<int>, Cmp> pq;
+    explicit ProcessHeapScheduler(const vector<Process>& procs):pq(Cmp{&procs}){}
+    bool empty() const { return pq.empty(); }
+    size_t size() const { return pq.size(); }
+    void enqueue(int i, int){ pq.push(i); }
+    int pick_next(int){ int i = pq.top(); pq.pop(); return i; }
+    int timeslice(int, int now, int next_arrival){ return next_arrival - now; }
+    void on_preempt(int i, int){ pq.push(i); }
+    int steal(int now){ return pick_next(now); }
+    void migrate_in(int i, int){ pq.push(i); }
+};
+
+// Time the PPS backends on the same input (one CPU, no output): the
+// array-of-structs heap, the packed-key heap and the bitmap priority array.
+// Check that all three produce the same schedule; with burst lists the array
+// breaks ties by wakeup rather than admission order, so only the heaps are
+// compared.
+void bench_priority(vector<Process> procs, int reps){
+    sort_for_priority(procs);
+    cout << "\n=== PPS backend benchmark (n = " << procs.size() << ", reps = " << reps << ") ===\n";
+    auto run = [&](auto make, Schedule& sched){
+        double best = 1e300;
+        for(int r=0;r<reps;r++){
+            ProcessTable t(procs);
+            PriorityArray::Links links(t.n);
+            auto rqs = make(t, links);
+            auto t0 = chrono::steady_clock::now();
+            sched = simulate(t, rqs);
+            auto t1 = chrono::steady_clock::now();
+            best = min(best, chrono::duration<double, milli>(t1 - t0).count());
+        }
+        return best;
+    };
+    Schedule aos_sched, heap_sched, array_sched;
+    double aos_ms = run([&](const ProcessTable&, PriorityArray::Links&){
+                            return vector<ProcessHeapScheduler>(1, ProcessHeapScheduler(procs)); },
+                        aos_sched);
+    double heap_ms = run([](const ProcessTable& t, PriorityArray::Links&){
+                             return vector<PriorityScheduler>(1, PriorityScheduler(t)); },
+                         heap_sched);
+    double array_ms = run([](const ProcessTable& t, PriorityArray::Links& links){
+                              return vector<PriorityArray>(1, PriorityArray(t, links)); },
+                          array_sched);
+    auto same_as = [&](const Schedule& other){
+        const vector<GanttEntry> &x = aos_sched.cpu[0], &y = other.cpu[0];
+        if(x.size() != y.size()) return false;
+        for(size_t i=0;i<x.size();i++)
+            if(x[i].pid != y[i].pid || x[i].start != y[i].start || x[i].end != y[i].end) return false;
+        return true;
+    };
+    bool blocks = any_of(procs.begin(), procs.end(), [](const Process& p){ return !p.bursts.empty(); });
+    bool same = same_as(heap_sched) && (blocks || same_as(array_sched));
+    auto speedup = [&](double ms){ return ms > 0 ? aos_ms / ms : 0.0; };
+    cout << fixed << setprecision(3);
+    cout << "heap, process structs  : " << aos_ms << " ms (best of " << reps << ")\n";
+    cout << "heap, packed keys      : " << heap_ms << " ms (" << speedup(heap_ms) << "x)\n";
+    cout << "bitmap priority array  : " << array_ms << " ms (" << speedup(array_ms) << "x)\n";
+    cout << "schedules identical    : " << (same ? "yes" : "NO") << (blocks ? " (heaps only: input has I/O)" : "") << "\n";
+}
+
+// bench [min=N] [max=N] [reps=R] [warmup=W] [policies=a,b,..]: time the
+// policy hot paths on runqueues of min, 10*min, .. max processes (default
+// 10 .. 10^7). Per policy and size:
+//   enqueue - enqueue into an empty runqueue until it holds n
+//   pick    - drain it: pick_next, then on_exit
+//   preempt - with n queued, one timeslice expiry: pick_next, timeslice,
+//             on_tick, on_preempt; "-" for srtf and edf, whose running
+//             process stays at the top of the heap, so an expiry moves
+//             nothing
+//   run     - simulate() on one CPU, no Gantt chart, all n arriving at 0
+// The micro-operations repeat until at least BENCH_MIN_OPS are timed, with
+// the clock's own cost subtracted. Each figure is the median of `reps`
+// samples after `warmup` untimed ones. The workload is fixed (seed 1):
+// bursts exponential with mean 4, priorities 0..19, every eighth process
+// SCHED_RR for mixed (unthrottled, as no policy timer fires between the
+// micro-operations). A new policy is benchmarked by adding an entry to
+// bench_policies().
+const long long BENCH_MIN_OPS = 1 << 20;
+
+struct BenchConfig {
+    long long min_n = 10, max_n = 10000000;
+    int reps = 3, warmup = 1;
+    vector<string> policies; // empty: all
+};
+
+// medians, per operation / per run; preempt_ns is NAN where it does not apply
+struct BenchResult {
+    double enqueue_ns = 0, pick_ns = 0, preempt_ns = 0;
+    double run_ms = 0, events_per_sec = 0;
+};
+
+double bench_clock_overhead_ns(){
+    const int calls = 1 << 16;
+    auto t0 = chrono::steady_clock::now(), t1 = t0;
+    for(int k=0;k<calls;k++) t1 = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(t1 - t0).count() / calls;
+}
+
+ProcessTable bench_workload(int n){
+    vector<Process> procs;
+    procs.reserve(n);
+    mt19937_64 rng(1);
+    exponential_distribution<double> burst(0.25);
+    for(int i=0;i<n;i++){
+        Process p(i + 1, 0, (int)min(1e9, ceil(burst(rng)) + 1), (int)(rng() % 20));
+        if(i % 8 == 0) p.policy = 2;
+        procs.push_back(p);
+    }
+    return ProcessTable(procs);
+}
+
+// with_rqs(t, body) builds one runqueue (and the per-row state it needs) over
+// table t and returns body(rqs)
+template<class WithRqs>
+BenchResult bench_policy(const ProcessTable& base, const BenchConfig& cfg, double clock_ns, WithRqs with_rqs,
+                         bool has_preempt = true){
+    int n = base.n;
+    using clk = chrono::steady_clock;
+    auto ns = [](clk::time_point a, clk::time_point b){ return chrono::duration<double, nano>(b - a).count(); };
+    auto median = [](vector<double> v){
+        sort(v.begin(), v.end());
+        return v[v.size() / 2];
+    };
+    vector<double> enq, pick, pre, run, eps;
+    for(int r=0;r<cfg.warmup+cfg.reps;r++){
+        ProcessTable t = base;
+        double e = 0, p = 0, q = 0;
+        long long rounds = max(1LL, BENCH_MIN_OPS / n);
+        with_rqs(t, [&](auto& rqs){
+            auto &rq = rqs[0];
+            int now = 0;
+            for(long long k=0;k<rounds;k++){
+                auto t0 = clk::now();
+                for(int i=0;i<n;i++) rq.enqueue(i, now);
+                auto t1 = clk::now();
+                for(int i=0;i<n;i++){
+                    int cur = rq.pick_next(now);
+                    int ran = min(max(1, rq.timeslice(cur, now, INT_MAX)), 4);
+                    now += ran;
+                    rq.on_tick(cur, ran, now);
+                    rq.on_preempt(cur, now);
+                }
+                auto t2 = clk::now();
+                for(int i=0;i<n;i++) rq.on_exit(rq.pick_next(now), now);
+                auto t3 = clk::now();
+                e += ns(t0, t1) - clock_ns;
+                q += ns(t1, t2) - clock_ns;
+                p += ns(t2, t3) - clock_ns;
+                if(now > INT_MAX / 2) now = 0;
+            }
+            return 0;
+        });
+        t = base;
+        Schedule sched;
+        double run_ns = 0;
+        with_rqs(t, [&](auto& rqs){
+            auto t0 = clk::now();
+            sched = simulate(t, rqs, SmpConfig(), false);
+            run_ns = ns(t0, clk::now());
+            return 0;
+        });
+        if(sched.stats.completed != n){
+            cerr << "bench: " << sched.stats.completed << " of " << n << " processes completed\n";
+            exit(1);
+        }
+        if(r < cfg.warmup) continue;
+        double ops = (double)rounds * n;
+        enq.push_back(max(0.0, e / ops));
+        pre.push_back(max(0.0, q / ops));
+        pick.push_back(max(0.0, p / ops));
+        run.push_back(run_ns / 1e6);
+        eps.push_back(sched.events / (run_ns / 1e9));
+    }
+    return {median(enq), median(pick), has_preempt ? median(pre) : NAN, median(run), median(eps)};
+}
+
+// name -> benchmark over a workload table; one entry per policy
+vector<pair<string, function<BenchResult(const ProcessTable&, const BenchConfig&, double)>>> bench_policies(){
+    using Fn = function<BenchResult(const ProcessTable&, const BenchConfig&, double)>;
+    vector<pair<string, Fn>> v;
+    v.emplace_back("rr", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable&, auto body){
+            vector<RoundRobin> rqs(1, RoundRobin(2));
+            return body(rqs);
+        });
+    });
+    v.emplace_back("pps", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<PriorityScheduler> rqs(1, PriorityScheduler(t));
+            return body(rqs);
+        });
+    });
+    v.emplace_back("pps-o1", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            PriorityArray::Links links(t.n);
+            vector<PriorityArray> rqs(1, PriorityArray(t, links));
+            return body(rqs);
+        });
+    });
+    v.emplace_back("srtf", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<int> pos(t.n);
+            vector<ShortestRemaining> rqs(1, ShortestRemaining(RemainingKey{&t}, true, pos));
+            return body(rqs);
+        }, false);
+    });
+    v.emplace_back("edf", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<uint32_t> deadline(t.n);
+            for(int i=0;i<t.n;i++) deadline[i] = t.arrival[i] + 4 * t.burst[i];
+            vector<int> pos(t.n);
+            vector<EarliestDeadline> rqs(1, EarliestDeadline(DeadlineKey{deadline.data()}, true, pos));
+            return body(rqs);
+        }, false);
+    });
+    v.emplace_back("cfs", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<FairEntity> se = make_fair_entities(t);
+            vector<Cfs> rqs(1, Cfs(se, 6, 1));
+            return body(rqs);
+        });
+    });
+    v.emplace_back("eevdf", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<FairEntity> se = make_fair_entities(t);
+            for(int i=0;i<t.n;i++) se[i].slice = t.burst[i];
+            vector<Eevdf> rqs(1, Eevdf(se));
+            return body(rqs);
+        });
+    });
+    v.emplace_back("mlfq", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<int> quantum = {2, 4, 8};
+            Mlfq::State st(t.n);
+            vector<Mlfq> rqs(1, Mlfq(quantum, 50, st));
+            return body(rqs);
+        });
+    });
+    v.emplace_back("mixed", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<int> policy(t.n), rt_level(t.n), rr_left(t.n);
+            for(int i=0;i<t.n;i+=8){
+                policy[i] = ClassScheduler::RR;
+                rt_level[i] = 98 - t.priority[i];
+            }
+            PriorityArray::Links links(t.n);
+            vector<FairEntity> se = make_fair_entities(t);
+            vector<ClassScheduler> rqs(1, ClassScheduler(rt_level.data(), links, se, policy, rr_left, 100,
+                                                         -1, 1000, 6, 1));
+            return body(rqs);
+        });
+    });
+    v.emplace_back("lottery", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<int> tickets = make_tickets(t);
+            vector<Lottery> rqs;
+            rqs.emplace_back(tickets, 2, 1);
+            return body(rqs);
+        });
+    });
+    v.emplace_back("stride", [](const ProcessTable& w, const BenchConfig& cfg, double clock_ns){
+        return bench_policy(w, cfg, clock_ns, [](ProcessTable& t, auto body){
+            vector<int> tickets = make_tickets(t);
+            vector<long long> pass(t.n);
+            vector<Stride> rqs(1, Stride(tickets, pass, 2));
+            return body(rqs);
+        });
+    });
+    return v;
+}
+
+int bench(const vector<string>& args){
+    BenchConfig cfg;
+    auto all = bench_policies();
+    for(size_t k=1;k<args.size();k++){
+        const string& a = args[k];
+        size_t eq = a.find('=');
+        string key = a.substr(0, eq), val = eq == string::npos ? "" : a.substr(eq + 1);
+        if(key == "min" || key == "max"){
+            long long v;
+            if(!parse_int(val, v) || v < 1 || v > INT_MAX / 8){
+                cerr << "bench: " << key << " must be 1.." << INT_MAX / 8 << "\n";
+                return 1;
+            }
+            (key == "min" ? cfg.min_n : cfg.max_n) = v;
+        } else if(key == "reps" || key == "warmup"){
+            long long v;
+            if(!parse_int(val, v) || v < (key == "reps") || v > INT_MAX){
+                cerr << "bench: bad " << key << " " << val << "\n";
+                return 1;
+            }
+            (key == "reps" ? cfg.reps : cfg.warmup) = (int)v;
+        } else if(key == "policies"){
+            stringstream ss(val);
+            for(string name; getline(ss, name, ',');){
+                bool known = false;
+                for(auto &e: all) known |= e.first == name;
+                if(!known){
+                    cerr << "bench: unknown policy " << name << " (";
+                    for(size_t j=0;j<all.size();j++) cerr << (j ? ", " : "") << all[j].first;
+                    cerr << ")\n";
+                    return 1;
+                }
+                cfg.policies.push_back(name);
+            }
+        } else {
+            cerr << "bench: unknown argument " << a << " (min=, max=, reps=, warmup=, policies=)\n";
+            return 1;
+        }
+    }
+    if(cfg.min_n > cfg.max_n){
+        cerr << "bench: min exceeds max\n";
+        return 1;
+    }
+    double clock_ns = bench_clock_overhead_ns();
+    cout << "=== Scheduler benchmark: median of " << cfg.reps << " after " << cfg.warmup
+         << " warmup, clock " << fixed << setprecision(1) << clock_ns << " ns ===\n";
+    cout << left << setw(9) << "Policy" << right << setw(10) << "n" << setw(12) << "enqueue" << setw(12) << "pick"
+         << setw(12) << "preempt" << setw(12) << "run ms" << setw(14) << "events/s" << "\n";
+    cout << setw(9 + 10 + 12) << "ns/op" << setw(12) << "ns/op" << setw(12) << "ns/op" << "\n";
+    for(long long n=cfg.min_n;n<=cfg.max_n;n*=10){
+        ProcessTable w = bench_workload((int)n);
+        for(auto &e: all){
+            if(!cfg.policies.empty() && find(cfg.policies.begin(), cfg.policies.end(), e.first) == cfg.policies.end())
+                continue;
+            BenchResult r = e.second(w, cfg, clock_ns);
+            cout << left << setw(9) << e.first << right << setw(10) << n << setprecision(1)
+                 << setw(12) << r.enqueue_ns << setw(12) << r.pick_ns;
+            if(isnan(r.preempt_ns)) cout << setw(12) << "-";
+            else cout << setw(12) << r.preempt_ns;
+            cout << setprecision(3) << setw(12) << r.run_ms << scientific << setprecision(2)
+                 << setw(14) << r.events_per_sec << fixed << "\n" << flush;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv){
+    ios::sync_with_stdio(false);
+    vector<string> args(argv, argv + argc); // args[0] stands where the mode name was
+    if(args.size() < 2 || args[1] != "pps") return bench(args);
+
+    long long reps = 5;
+    if(args.size() >= 3 && (!parse_int(args[2], reps) || reps > INT_MAX)){
+        cerr << "pps: expected an integer, got " << args[2] << "\n";
+        return 1;
+    }
+    InputBuffer in;
+    vector<Process> procs;
+    if(!in.open(args.size() >= 4 ? args[3] : "") || !load_processes(in, procs)) return 1;
+    for(auto &p: procs){
+        if(p.priority < 0 || p.priority >= PriorityArray::MAX_PRIO){
+            cerr << "pps: priority of P" << p.pid << " outside 0.." << PriorityArray::MAX_PRIO - 1 << "\n";
+            return 1;
+        }
+    }
+    bench_priority(procs, (int)max(1LL, reps));
+    return 0;
+}
@@ -0,0 +1,47 @@
+# PGO training run (target pgo-train of a SCHEDSIM_PGO=GENERATE build):
+# the instrumented scheduler generates the bundled workload, a fixed-seed
+# synthetic trace of 500000 processes (steady Poisson arrivals, then a
+# bursty MMPP variant), and runs every mode over it on one and four CPUs.
+# Clang's raw profiles are then merged into schedsim.profdata.
+#   cmake -DSCHEDULER=.. -DPROFILE_DIR=.. -DWORK_DIR=.. -DCOMPILER_ID=..
+#         [-DLLVM_PROFDATA=..] -P pgo-train.cmake
+
+file(REMOVE_RECURSE "${PROFILE_DIR}")
+file(MAKE_DIRECTORY "${PROFILE_DIR}" "${WORK_DIR}")
+
+function(run)
+    execute_process(COMMAND "${SCHEDULER}" ${ARGN} RESULT_VARIABLE rc OUTPUT_QUIET)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "training run failed (${rc}): scheduler ${ARGN}")
+    endif()
+endfunction()
+
+set(steady "${WORK_DIR}/steady.txt")
+set(bursty "${WORK_DIR}/bursty.bin")
+run(gen 500000 seed=1 burst=exp:4 prio=0:60,5:20,10:10,19:10 out=${steady})
+run(gen 500000 seed=2 arrival=mmpp:1,0.05,0.01,0.01 burst=pareto:1.5,2 format=bin out=${bursty})
+
+foreach(input IN ITEMS "${steady}" "${bursty}")
+    foreach(cpus IN ITEMS 1 4)
+        foreach(mode IN ITEMS "rr;4" "pps" "pps-o1" "sjf" "srtf" "cfs" "eevdf;8" "mlfq;3;2;50" "mixed"
+                              "lottery;2;1" "stride;2")
+            run(--metrics-only --cpus ${cpus} --input ${input} ${mode})
+        endforeach()
+    endforeach()
+    run(--cpus 4 --input ${input} stream cfs)
+endforeach()
+run(--input ${steady} rr 4)
+run(--input ${steady} sweep 1 8)
+run(convert text2bin ${steady} ${WORK_DIR}/steady.bin)
+
+if(COMPILER_ID MATCHES "Clang")
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "llvm-profdata not found; it is needed to merge Clang profiles")
+    endif()
+    file(GLOB raw "${PROFILE_DIR}/*.profraw")
+    execute_process(COMMAND "${LLVM_PROFDATA}" merge -output=${PROFILE_DIR}/schedsim.profdata ${raw}
+                    RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "llvm-profdata merge failed")
+    endif()
+endif()
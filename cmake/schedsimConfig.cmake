@@ -0,0 +1,4 @@
+# find_package(schedsim) entry point of an installed tree
+include(CMakeFindDependencyMacro)
+find_dependency(Threads)
+include("${CMAKE_CURRENT_LIST_DIR}/schedsimTargets.cmake")
@@ -0,0 +1,47 @@
+// schedsim/gen.hpp - synthetic workload generator
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace schedsim {
+
+// gen: synthetic workloads. Arrivals are Poisson or a two-state MMPP (a
+// Poisson process whose rate switches between rate0 and rate1, for bursty
+// traffic); bursts are exponential, lognormal or Pareto (rounded up, at least
+// 1); priorities come from a weighted mix.
+struct Distribution {
+    std::string kind;
+    std::vector<double> a; // parameters, in the order of the spec
+};
+
+struct GenConfig {
+    long long n = 0;
+    Distribution arrival{"poisson", {0.2}};
+    Distribution burst{"exp", {4}};
+    std::vector<std::pair<int,double>> prio{{0, 1}}; // (priority, weight)
+    uint64_t seed = 1;
+    std::string out = "-";
+    bool binary = false;
+};
+
+// "kind:a,b,...", with the number of parameters checked against the kind;
+// each must be a number of magnitude at most 1e12, signs are left to the caller
+bool parse_distribution(const std::string& spec, const std::map<std::string,int>& kinds, Distribution& d);
+
+// Two parallel passes over the chunks: the first draws the arrival gaps and
+// bursts, giving each chunk's time span and so, by a prefix sum, its start
+// time, plus the total work, which must fit the simulated clock with the
+// arrivals; the second regenerates and formats the chunks, a window at a
+// time, and writes them in order. The output depends on the seed, not on the
+// thread count.
+int generate(const GenConfig& g, int threads);
+
+// gen N [arrival=...] [burst=...] [prio=...] [seed=S] [out=FILE] [format=text|bin]
+int gen(const std::vector<std::string>& args, int threads);
+
+} // namespace schedsim
@@ -0,0 +1,81 @@
+// schedsim/indexed_heap.hpp - indexed d-ary heap with decrease-key
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace schedsim {
+
+// Indexed D-ary min-heap of 64-bit keys whose low 32 bits are the element's
+// index. pos[i] locates element i in the array (elements are never in two
+// heaps at once, so several heaps can share one pos array), which makes
+// changing the key of, or removing, any element O(D log_D n).
+template<int D>
+struct IndexedHeap {
+    std::vector<uint64_t> a;
+    int* pos;
+
+    explicit IndexedHeap(int* pos):pos(pos){}
+
+    bool empty() const { return a.empty(); }
+    size_t size() const { return a.size(); }
+    uint64_t top() const { return a[0]; }
+    static int index(uint64_t key){ return (uint32_t)key; }
+    uint64_t key(int i) const { return a[pos[i]]; }
+
+    void place(size_t k, uint64_t key){ a[k] = key; pos[index(key)] = k; }
+
+    void sift_up(size_t k){
+        uint64_t key = a[k];
+        while(k > 0){
+            size_t parent = (k - 1) / D;
+            if(a[parent] <= key) break;
+            place(k, a[parent]);
+            k = parent;
+        }
+        place(k, key);
+    }
+
+    void sift_down(size_t k){
+        uint64_t key = a[k];
+        size_t n = a.size();
+        while(true){
+            size_t first = k * D + 1;
+            if(first >= n) break;
+            size_t best = first, last = std::min(first + D, n);
+            for(size_t c=first+1;c<last;c++) if(a[c] < a[best]) best = c;
+            if(a[best] >= key) break;
+            place(k, a[best]);
+            k = best;
+        }
+        place(k, key);
+    }
+
+    void push(uint64_t key){
+        a.push_back(key);
+        sift_up(a.size() - 1);
+    }
+
+    // new key for element i, in either direction
+    void update(uint64_t key){
+        size_t k = pos[index(key)];
+        uint64_t old = a[k];
+        a[k] = key;
+        if(key < old) sift_up(k); else sift_down(k);
+    }
+
+    void remove(int i){
+        size_t k = pos[i];
+        uint64_t last = a.back();
+        a.pop_back();
+        if(k == a.size()) return;
+        uint64_t old = a[k];
+        a[k] = last;
+        if(last < old) sift_up(k); else sift_down(k);
+    }
+};
+
+} // namespace schedsim
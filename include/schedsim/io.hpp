@@ -0,0 +1,177 @@
+// schedsim/io.hpp - process lists, binary traces and kernel sched dumps
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "schedsim/process.hpp"
+#include "schedsim/schedule.hpp"
+
+namespace schedsim {
+
+// Whole trace as one contiguous buffer: mmap'd when the source is a regular
+// file (including redirected stdin), otherwise read in large chunks.
+struct InputBuffer {
+    const char* data = nullptr;
+    size_t size = 0;
+    void* map = nullptr;
+    std::vector<char> buf;
+
+    InputBuffer() = default;
+    InputBuffer(const InputBuffer&) = delete;
+    InputBuffer& operator=(const InputBuffer&) = delete;
+    ~InputBuffer();
+
+    // path "" or "-" reads stdin
+    bool open(const std::string& path);
+};
+
+// simulate() keeps time in an int: no schedule runs past the latest arrival
+// plus all CPU and I/O time, so inputs are refused once that bound passes
+// INT_MAX
+struct SpanCheck {
+    long long latest = 0, work = 0;
+    bool add(long long arrival, long long burst, long long io){
+        latest = std::max(latest, arrival);
+        work += burst + io;
+        return latest + work <= INT_MAX;
+    }
+};
+const char* const SPAN_ERROR = "arrival plus total CPU and I/O time exceeds the simulated clock (INT_MAX)";
+
+// Split one line into up to `max` integers. Returns the number found, or -1
+// if a token is not an integer (bad_col set to its 1-based column). With
+// `list`, the third token may also be a comma-separated list, whose items go
+// to *list (left empty for a plain integer; out[2] is then unset).
+int scan_ints(const char* p, const char* end, long long* out, int max, int& bad_col,
+              std::vector<long long>* list = nullptr);
+
+// The whole of s as a decimal integer, e.g. a command-line value.
+bool parse_int(const std::string& s, long long& v);
+
+// Parse "n" followed by n lines of "pid arrival burst priority [policy]
+// [deadline period]": the optional policy is for mixed, the optional pair for
+// edf. A process that blocks gives its bursts as a list "cpu,io,cpu,...,cpu"
+// and burst is then its total CPU time. Blank lines are skipped. Every
+// malformed line is counted and the first few reported with their line
+// numbers; nothing is returned unless the whole trace is valid.
+bool parse_processes(const char* data, size_t size, std::vector<Process>& procs);
+
+// Binary trace format, version 1. Everything is little-endian and fixed
+// width: a 64-byte header followed by `count` 16-byte records, so a mapped
+// file's records are read directly and copied into processes without any
+// text parsing.
+//   header:  magic "SCHEDSIM", version, kind, count, record_size, cpus,
+//            algorithm (NUL-padded mode name), params[4] (mode parameters)
+//   kind 1 (processes): pid, arrival, burst, priority
+//   kind 2 (gantt):     cpu, pid (-1 = idle), start, end
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "binary traces are read in place and assume a little-endian host");
+
+const char TRACE_MAGIC[8] = {'S','C','H','E','D','S','I','M'};
+const uint32_t TRACE_VERSION = 1;
+enum TraceKind : uint32_t { TRACE_PROCESSES = 1, TRACE_GANTT = 2 };
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint64_t count;
+    uint32_t record_size;
+    uint32_t cpus;
+    char algorithm[16];
+    int32_t params[4];
+};
+static_assert(sizeof(TraceHeader) == 64, "trace header layout");
+
+struct ProcessRecord { int32_t pid, arrival, burst, priority; };
+struct GanttRecord { int32_t cpu, pid, start, end; };
+static_assert(sizeof(ProcessRecord) == 16 && sizeof(GanttRecord) == 16, "trace record layout");
+
+TraceHeader make_trace_header(TraceKind kind, uint64_t count, uint32_t record_size);
+
+bool is_binary_trace(const char* data, size_t size);
+
+// version, kind and record size of a header, with a message on mismatch
+bool check_trace_header(const TraceHeader& h, TraceKind kind, uint32_t record_size);
+
+// Validate the header of a mapped trace and return it, or null (with a
+// message on stderr) if it is not a complete trace of the wanted kind.
+const TraceHeader* trace_header(const char* data, size_t size, TraceKind kind, uint32_t record_size);
+
+// Build the process list straight from the mapped records
+bool load_processes_binary(const char* data, size_t size, std::vector<Process>& procs);
+
+// a dump whose first lines mention sched_switch and whose first line is not
+// a process count
+bool is_sched_trace(const char* data, size_t size);
+
+// processes rebuilt from a sched_switch / sched_wakeup dump (see
+// SchedTraceImporter in io.cpp), times in units of unit_us microseconds
+bool load_sched_trace(const char* data, size_t size, std::vector<Process>& procs, long long unit_us);
+
+// text, binary (by the magic bytes) or a sched event dump
+bool load_processes(const InputBuffer& in, std::vector<Process>& procs, long long trace_unit_us = 1);
+
+// Incremental process reader for stream mode: the trace passes through one
+// fixed buffer, so memory does not grow with its length and input from a
+// pipe is consumed as it arrives. Takes the text format (the count line is
+// optional, since a stream has no known length) or a binary process trace,
+// and requires arrivals in non-decreasing order.
+struct ProcessReader {
+    static const size_t CAP = 1 << 16; // also the longest accepted line
+    int fd = -1;
+    bool own_fd = false;
+    std::unique_ptr<char[]> buf;
+    size_t begin = 0, end = 0;
+    bool eof = false;
+    bool failed = false;
+    bool binary = false;
+    uint64_t records_left = 0; // binary: records still promised by the header
+    long long line_no = 0;     // text line, or binary record, last read
+    bool started = false;      // text: a non-blank line has been read
+    bool any = false;          // a process has been read
+    int last_arrival = 0;
+    long long busy_until = 0;  // bound on the simulated clock, see SpanCheck
+
+    ProcessReader():buf(new char[CAP]){}
+    ProcessReader(const ProcessReader&) = delete;
+    ProcessReader& operator=(const ProcessReader&) = delete;
+    ~ProcessReader();
+
+    // path "" or "-" reads stdin
+    bool open(const std::string& path);
+
+    // read until at least `want` bytes are buffered or the input ends
+    void fill(size_t want);
+
+    bool error(const std::string& msg);
+
+    // next process, or false at the end of input or on an error (failed set)
+    bool next(Process& p);
+};
+
+// path "-" writes stdout
+bool write_trace(const std::string& path, const TraceHeader& h, const void* records, size_t bytes);
+
+bool write_processes_binary(const std::string& path, const std::vector<Process>& procs);
+
+bool write_gantt_binary(const std::string& path, const Schedule& sched);
+
+// text process list; the policy and deadline columns only when some process
+// has them
+void write_processes_text(std::ostream& out, const std::vector<Process>& procs);
+
+// convert text2bin IN OUT: text process list -> binary ("-" = stdin/stdout)
+// convert bin2text IN OUT: binary processes -> text process list, or binary
+//                          gantt -> "# algorithm ..." line, m, "cpu pid start end" lines
+// convert trace2text IN OUT: sched event dump -> text process list with burst lists
+int convert(const std::string& how, const std::string& in_path, const std::string& out_path, long long trace_unit_us);
+
+} // namespace schedsim
@@ -0,0 +1,144 @@
+// schedsim/modes.hpp - one run per mode: admission order, simulation, results
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "schedsim/process.hpp"
+#include "schedsim/report.hpp"
+#include "schedsim/schedule.hpp"
+#include "schedsim/simulate.hpp"
+
+namespace schedsim {
+
+// RR / CFS / EEVDF admission order: arrival, then pid
+void sort_by_arrival(std::vector<Process>& procs);
+
+// PPS admission order: arrival, then priority, then pid
+void sort_for_priority(std::vector<Process>& procs);
+
+// run_* sort procs into admission order, simulate on a ProcessTable and
+// store the results back; the printing wrappers below and the sweep share them.
+// Without record_gantt only the metrics are kept.
+
+Schedule run_round_robin(std::vector<Process>& procs, int quantum, const SmpConfig& smp,
+                         bool record_gantt = true);
+
+Schedule run_preemptive_priority(std::vector<Process>& procs, const SmpConfig& smp,
+                                 bool record_gantt = true);
+
+Schedule run_preemptive_priority_o1(std::vector<Process>& procs, const SmpConfig& smp,
+                                    bool record_gantt = true);
+
+Schedule run_completely_fair(std::vector<Process>& procs, int sched_latency, int min_granularity,
+                             const SmpConfig& smp, bool record_gantt = true);
+
+Schedule run_earliest_eligible_deadline(std::vector<Process>& procs, int max_slice, const SmpConfig& smp,
+                                        bool record_gantt = true);
+
+// mixed: per-class summary, then RT throttling summed over CPUs
+Schedule run_mixed(std::vector<Process>& procs, int rr_timeslice, int rt_runtime, int rt_period, int sched_latency,
+                   int min_granularity, const SmpConfig& smp, bool record_gantt = true);
+
+std::vector<int> make_tickets(const ProcessTable& t);
+
+// Lag: each process's CPU time (its burst) minus what an ideal fluid
+// scheduler would have given it between arrival and completion: at every
+// moment min(cpus, runnable) CPUs are split among the runnable processes in
+// proportion to their tickets. That share is w * (V(completion) - V(arrival))
+// for the virtual time V, dV/dt = CPUs / runnable tickets, so one merge of
+// arrivals and completions suffices. procs must be sorted by arrival; time
+// blocked in I/O counts as runnable.
+ShareStats share_stats(const std::vector<Process>& procs, int cpus);
+
+Schedule run_lottery(std::vector<Process>& procs, int quantum, uint32_t seed, const SmpConfig& smp,
+                     bool record_gantt = true);
+
+Schedule run_stride(std::vector<Process>& procs, int quantum, const SmpConfig& smp, bool record_gantt = true);
+
+Schedule run_shortest_remaining(std::vector<Process>& procs, bool preemptive, const SmpConfig& smp,
+                                bool record_gantt = true);
+
+const double DL_BW_LIMIT = 0.95; // per CPU, cf. sched_rt_runtime_us / sched_rt_period_us
+
+// Admission control, then job release. Periodic tasks are admitted in
+// arrival order while their total bandwidth runtime/period stays within
+// DL_BW_LIMIT per CPU; like sched_setattr(), a task that would exceed it, or
+// that breaks runtime <= deadline <= period, is refused. Single jobs (period
+// 0) are always admitted. An admitted task releases a job every period from
+// its arrival until `horizon`, each due `deadline` (default: the period)
+// after its release.
+std::vector<Process> release_jobs(std::vector<Process> tasks, int horizon, int cpus, DeadlineStats& ds);
+
+// most jobs an edf run may release, each a full Process row
+const long long MAX_JOBS = 1 << 22;
+
+// jobs release_jobs() would release if every task were admitted
+long long count_jobs(const std::vector<Process>& tasks, int horizon);
+
+// procs holds the tasks on entry and their released jobs on return
+Schedule run_earliest_deadline(std::vector<Process>& procs, int horizon, const SmpConfig& smp,
+                               bool record_gantt = true);
+
+// per-level quanta and the boost period, summed over CPUs into the schedule
+Schedule run_multi_level_feedback(std::vector<Process>& procs, const std::vector<int>& quantum, int boost_interval,
+                                  const SmpConfig& smp, bool record_gantt = true);
+
+// The printing wrappers return false if the --gantt-out trace could not be
+// written.
+
+// Round Robin (quantum) - preemptive by design
+bool round_robin(std::vector<Process> procs, int quantum, const SmpConfig& smp = SmpConfig(),
+                 const OutputConfig& output = OutputConfig());
+
+// Preemptive Priority Scheduling (smaller priority value => higher priority)
+// Event-driven: one heap pop/push per arrival or completion, not per time unit
+bool preemptive_priority(std::vector<Process> procs, const SmpConfig& smp = SmpConfig(),
+                         const OutputConfig& output = OutputConfig());
+
+// Preemptive Priority Scheduling on the O(1) bitmap priority array
+bool preemptive_priority_o1(std::vector<Process> procs, const SmpConfig& smp = SmpConfig(),
+                            const OutputConfig& output = OutputConfig());
+
+// Completely Fair Scheduler (priority = nice value, -20..19)
+bool completely_fair(std::vector<Process> procs, int sched_latency, int min_granularity,
+                     const SmpConfig& smp = SmpConfig(), const OutputConfig& output = OutputConfig());
+
+// Shortest Job First (non-preemptive) or Shortest Remaining Time First
+bool shortest_remaining(std::vector<Process> procs, bool preemptive, const SmpConfig& smp = SmpConfig(),
+                        const OutputConfig& output = OutputConfig());
+
+// SCHED_FIFO / SCHED_RR / SCHED_OTHER by the policy column, RT throttled,
+// SCHED_OTHER under CFS with sched_latency and min_granularity
+bool mixed(std::vector<Process> procs, int rr_timeslice, int rt_runtime, int rt_period, int sched_latency,
+           int min_granularity, const SmpConfig& smp = SmpConfig(), const OutputConfig& output = OutputConfig());
+
+// Lottery scheduling (tickets = nice weight of the priority, seeded draws)
+bool lottery(std::vector<Process> procs, int quantum, uint32_t seed, const SmpConfig& smp = SmpConfig(),
+             const OutputConfig& output = OutputConfig());
+
+// Stride scheduling (tickets = nice weight of the priority)
+bool stride(std::vector<Process> procs, int quantum, const SmpConfig& smp = SmpConfig(),
+            const OutputConfig& output = OutputConfig());
+
+// Earliest Deadline First over periodic tasks (input columns deadline and
+// period); the table lists every released job
+bool earliest_deadline_first(std::vector<Process> procs, int horizon, const SmpConfig& smp = SmpConfig(),
+                             const OutputConfig& output = OutputConfig());
+
+// Multi-Level Feedback Queue (priority unused: every process starts at level 0)
+bool multi_level_feedback(std::vector<Process> procs, const std::vector<int>& quantum, int boost_interval,
+                          const SmpConfig& smp = SmpConfig(), const OutputConfig& output = OutputConfig());
+
+// EEVDF (priority = nice value, request size = burst capped at max_slice)
+bool earliest_eligible_deadline(std::vector<Process> procs, int max_slice, const SmpConfig& smp = SmpConfig(),
+                                const OutputConfig& output = OutputConfig());
+
+// Parse once, then run RR for every quantum in [qmin, qmax] (step qstep)
+// plus PPS, each on its own copy of the process list, spread over a pool of
+// `threads` workers; print one comparison row per configuration, then the
+// RR runs' histograms merged into one distribution.
+void sweep(const std::vector<Process>& procs, int qmin, int qmax, int qstep, int threads, const SmpConfig& smp);
+
+} // namespace schedsim
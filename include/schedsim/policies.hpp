@@ -0,0 +1,880 @@
+// schedsim/policies.hpp - scheduling policies
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "schedsim/indexed_heap.hpp"
+#include "schedsim/process.hpp"
+#include "schedsim/rbtree.hpp"
+#include "schedsim/simulate.hpp"
+
+namespace schedsim {
+
+// Round Robin: FIFO runqueue, fixed quantum, preempted process goes to the tail
+struct RoundRobin : Scheduler {
+    std::deque<int> q; // indices into procs
+    int quantum;
+    explicit RoundRobin(int quantum):quantum(quantum){}
+    bool empty() const { return q.empty(); }
+    size_t size() const { return q.size(); }
+    void enqueue(int i, int){ q.push_back(i); }
+    int pick_next(int){ int i = q.front(); q.pop_front(); return i; }
+    int timeslice(int, int, int){ return quantum; }
+    void on_preempt(int i, int){ q.push_back(i); }
+    // migrate the most recently queued process; it had the longest wait ahead
+    int steal(int){ int i = q.back(); q.pop_back(); return i; }
+    void migrate_in(int i, int){ q.push_back(i); }
+};
+
+// Multi-Level Feedback Queue: level 0 is the highest priority and each level
+// is a FIFO with its own quantum. Arrivals enter level 0. A process that has
+// used up its level's quantum, in one slice or across several, drops a level;
+// one interrupted earlier resumes from the head of its level. Every
+// boost_interval (0 = never) all processes return to level 0, so long jobs
+// cannot starve. Like PPS, a slice also ends at the next arrival, which may
+// belong to a higher level.
+// Levels are intrusive lists (as in PriorityArray), so a boost splices them
+// onto level 0 in O(levels); each process's level and quantum use are reset
+// lazily when it is next touched, by comparing its boost epoch.
+struct Mlfq : Scheduler {
+    static const int MAX_LEVELS = 64;
+
+    // per-process list links, level, quantum used at that level and the boost
+    // epoch both were set in; shared by all CPUs
+    struct State {
+        std::vector<int> next, prev, level, used, epoch;
+        explicit State(int n):next(n, -1), prev(n, -1), level(n, -1), used(n, 0), epoch(n, 0){}
+    };
+
+    const std::vector<int>* quantum;
+    int boost_interval;
+    State* st;
+    std::vector<int> head, tail, len;
+    uint64_t bitmap = 0; // non-empty levels
+    size_t count = 0;
+    int epoch = 0;       // boosts so far
+    int next_boost;
+    std::vector<LevelStats> stats;
+    std::vector<int> last_change; // last time each level's length changed
+
+    Mlfq(const std::vector<int>& quantum, int boost_interval, State& st)
+        :quantum(&quantum), boost_interval(boost_interval), st(&st),
+         head(quantum.size(), -1), tail(quantum.size(), -1), len(quantum.size(), 0),
+         next_boost(boost_interval > 0 ? boost_interval : INT_MAX),
+         stats(quantum.size()), last_change(quantum.size(), 0){
+        for(size_t l=0;l<quantum.size();l++) stats[l].quantum = quantum[l];
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    int levels() const { return head.size(); }
+
+    // bring i's level and quantum use into the current boost epoch
+    void sync(int i){
+        if(st->epoch[i] == epoch) return;
+        st->epoch[i] = epoch;
+        st->level[i] = 0;
+        st->used[i] = 0;
+    }
+
+    // account queue occupancy up to now
+    void touch(int l, int now){
+        stats[l].queued_time += (long long)len[l] * (now - last_change[l]);
+        last_change[l] = now;
+    }
+
+    void push(int i, int now, bool front){
+        int l = st->level[i];
+        touch(l, now);
+        int *next = st->next.data(), *prev = st->prev.data();
+        if(front){
+            prev[i] = -1; next[i] = head[l];
+            if(head[l] >= 0) prev[head[l]] = i; else tail[l] = i;
+            head[l] = i;
+        } else {
+            next[i] = -1; prev[i] = tail[l];
+            if(tail[l] >= 0) next[tail[l]] = i; else head[l] = i;
+            tail[l] = i;
+        }
+        len[l]++;
+        bitmap |= 1ULL << l;
+        count++;
+    }
+
+    int pop(int l, int now, bool back = false){
+        touch(l, now);
+        int *next = st->next.data(), *prev = st->prev.data();
+        int i;
+        if(back){
+            i = tail[l];
+            tail[l] = prev[i];
+            if(tail[l] >= 0) next[tail[l]] = -1; else head[l] = -1;
+        } else {
+            i = head[l];
+            head[l] = next[i];
+            if(head[l] >= 0) prev[head[l]] = -1; else tail[l] = -1;
+        }
+        if(--len[l] == 0) bitmap &= ~(1ULL << l);
+        count--;
+        sync(i);
+        return i;
+    }
+
+    void maybe_boost(int now){
+        if(now < next_boost) return;
+        int *next = st->next.data(), *prev = st->prev.data();
+        for(int l=0;l<levels();l++) touch(l, now);
+        for(int l=1;l<levels();l++){
+            if(len[l] == 0) continue;
+            if(tail[0] >= 0){ next[tail[0]] = head[l]; prev[head[l]] = tail[0]; }
+            else head[0] = head[l];
+            tail[0] = tail[l];
+            len[0] += len[l];
+            head[l] = tail[l] = -1;
+            len[l] = 0;
+        }
+        bitmap = count ? 1 : 0;
+        epoch += (now - next_boost) / boost_interval + 1;
+        next_boost = (now / boost_interval + 1) * boost_interval;
+    }
+
+    // arrivals (level -1) enter level 0; a process waking from I/O keeps
+    // its level and the quantum it has used there, so sleeping just before
+    // the quantum runs out does not keep a process on top
+    void enqueue(int i, int now){
+        maybe_boost(now);
+        if(st->level[i] < 0){
+            st->epoch[i] = epoch;
+            st->level[i] = 0;
+            st->used[i] = 0;
+        }
+        sync(i);
+        expire(i);
+        push(i, now, false);
+    }
+
+    // a process that has used up its quantum drops a level with a fresh one
+    bool expire(int i){
+        if(st->used[i] < (*quantum)[st->level[i]]) return false;
+        if(st->level[i] + 1 < levels()){
+            st->level[i]++;
+            stats[st->level[i]].demotions++;
+        }
+        st->used[i] = 0;
+        return true;
+    }
+
+    int pick_next(int now){
+        maybe_boost(now);
+        return pop(__builtin_ctzll(bitmap), now);
+    }
+
+    int timeslice(int i, int now, int next_arrival){
+        int left = (*quantum)[st->level[i]] - st->used[i];
+        return std::min({left, next_arrival - now, next_boost - now});
+    }
+
+    // the slice never crosses a boost, so it is charged to the level it ran at
+    void on_tick(int i, int ran, int now){
+        stats[st->level[i]].run_time += ran;
+        st->used[i] += ran;
+        maybe_boost(now);
+    }
+
+    void on_preempt(int i, int now){
+        if(st->epoch[i] != epoch){
+            // boosted while running: back to level 0 behind the others
+            sync(i);
+            push(i, now, false);
+        } else if(expire(i)){
+            push(i, now, false);
+        } else {
+            push(i, now, true);
+        }
+    }
+
+    // migrate the most recently queued process of the lowest non-empty level,
+    // which had the longest wait ahead
+    int steal(int now){
+        maybe_boost(now);
+        return pop(63 - __builtin_clzll(bitmap), now, true);
+    }
+
+    void migrate_in(int i, int now){
+        maybe_boost(now);
+        push(i, now, false);
+    }
+};
+
+// Runnable processes, including the one running, in an indexed 4-ary heap
+// ordered by Key (a 64-bit key with the table index in the low half, so ties
+// go by arrival then pid). Nothing is popped and re-pushed on preemption: the
+// running process stays in the heap, and a Key that changes as the process
+// runs is updated in place by charging. Preemptive modes grant the CPU until
+// the next arrival, the only event that can change the minimum; otherwise
+// until completion.
+template<class Key>
+struct HeapScheduler : Scheduler {
+    Key key;
+    bool preemptive;
+    IndexedHeap<4> heap;
+    int running = -1; // in the heap but not queued
+
+    HeapScheduler(Key key, bool preemptive, std::vector<int>& pos):key(key), preemptive(preemptive), heap(pos.data()){}
+
+    bool empty() const { return size() == 0; }
+    size_t size() const { return heap.size() - (running >= 0); }
+    void enqueue(int i, int){ heap.push(key(i)); }
+    int pick_next(int){ return running = IndexedHeap<4>::index(heap.top()); }
+    int timeslice(int, int now, int next_arrival){ return preemptive ? next_arrival - now : INT_MAX; }
+    void on_tick(int i, int, int){ if(Key::dynamic) heap.update(key(i)); }
+    void on_preempt(int, int){ running = -1; }
+    void on_exit(int i, int){ heap.remove(i); running = -1; }
+
+    // a leaf: among the largest keys, and cheap to remove
+    int steal(int){
+        int i = IndexedHeap<4>::index(heap.a.back());
+        if(i == running) i = IndexedHeap<4>::index(heap.a[heap.size() - 2]);
+        heap.remove(i);
+        return i;
+    }
+    void migrate_in(int i, int){ heap.push(key(i)); }
+};
+
+// SJF / SRTF: shortest remaining time first. Charging the running process
+// is a decrease-key at the top of the heap, which never moves it.
+struct RemainingKey {
+    static const bool dynamic = true;
+    const ProcessTable* t;
+    uint64_t operator()(int i) const { return (uint64_t)(uint32_t)t->remaining[i] << 32 | (uint32_t)i; }
+};
+using ShortestRemaining = HeapScheduler<RemainingKey>;
+
+// EDF: earliest absolute deadline first, from a per-row array of deadlines
+// (UINT32_MAX = none, run last)
+struct DeadlineKey {
+    static const bool dynamic = false;
+    const uint32_t* deadline;
+    uint64_t operator()(int i) const { return (uint64_t)deadline[i] << 32 | (uint32_t)i; }
+};
+using EarliestDeadline = HeapScheduler<DeadlineKey>;
+
+// Preemptive Priority: min-heap by priority then arrival then pid. The heap
+// holds the packed 64-bit keys themselves, so a comparison is one integer
+// compare with no lookups into the process table. Priorities are static, so
+// the running process can only be preempted by an arrival: it is granted the
+// CPU until the next arrival (or completion).
+struct PriorityScheduler : Scheduler {
+    const ProcessTable* t;
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> pq;
+    explicit PriorityScheduler(const ProcessTable& t):t(&t){}
+    bool empty() const { return pq.empty(); }
+    size_t size() const { return pq.size(); }
+    void enqueue(int i, int){ pq.push(t->key[i]); }
+    int pick_next(int){ int i = (uint32_t)pq.top(); pq.pop(); return i; }
+    int timeslice(int, int now, int next_arrival){ return next_arrival - now; }
+    void on_preempt(int i, int){ pq.push(t->key[i]); }
+    // like RT push/pull, hand the highest-priority waiting process to the
+    // CPU that has room for it
+    int steal(int now){ return pick_next(now); }
+    void migrate_in(int i, int){ pq.push(t->key[i]); }
+};
+
+// Preemptive Priority on an O(1)-scheduler style priority array: one FIFO
+// per priority level (intrusive lists threaded through per-process next/prev
+// slots shared by all CPUs, since a process is on at most one list) and a
+// bitmap of non-empty levels, so pick-next is a find-first-set
+// over three words. Priorities must lie in [0, MAX_PRIO). Admission order is
+// arrival then pid and a preempted process returns to the head of its level,
+// so on one CPU without I/O the schedule matches PriorityScheduler exactly.
+// A process waking from I/O joins the tail of its level, whereas the heap
+// ranks it by admission index, so with burst lists equal priorities can run
+// in a different order.
+struct PriorityArray : Scheduler {
+    static const int MAX_PRIO = 140;
+    static const int WORDS = (MAX_PRIO + 63) / 64;
+
+    // per-process list links, -1 terminated
+    struct Links {
+        std::vector<int> next, prev;
+        explicit Links(int n):next(n, -1), prev(n, -1){}
+    };
+
+    const int* prio; // level of each row
+    int* next;
+    int* prev;
+    uint64_t bitmap[WORDS] = {};
+    int head[MAX_PRIO], tail[MAX_PRIO];
+    size_t count = 0;
+
+    PriorityArray(const int* prio, Links& links)
+        :prio(prio), next(links.next.data()), prev(links.prev.data()){
+        std::fill(head, head + MAX_PRIO, -1);
+        std::fill(tail, tail + MAX_PRIO, -1);
+    }
+    PriorityArray(const ProcessTable& t, Links& links):PriorityArray(t.priority.data(), links){}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    int level(int i) const { return prio[i]; }
+
+    void push_back(int i){
+        int l = level(i);
+        next[i] = -1; prev[i] = tail[l];
+        if(tail[l] >= 0) next[tail[l]] = i; else head[l] = i;
+        tail[l] = i;
+        bitmap[l >> 6] |= 1ULL << (l & 63);
+        count++;
+    }
+
+    void push_front(int i){
+        int l = level(i);
+        prev[i] = -1; next[i] = head[l];
+        if(head[l] >= 0) prev[head[l]] = i; else tail[l] = i;
+        head[l] = i;
+        bitmap[l >> 6] |= 1ULL << (l & 63);
+        count++;
+    }
+
+    int pop_first(){
+        int l = 0;
+        for(int w=0;w<WORDS;w++){
+            if(bitmap[w]){ l = w * 64 + __builtin_ctzll(bitmap[w]); break; }
+        }
+        int i = head[l];
+        head[l] = next[i];
+        if(head[l] >= 0) prev[head[l]] = -1;
+        else { tail[l] = -1; bitmap[l >> 6] &= ~(1ULL << (l & 63)); }
+        count--;
+        return i;
+    }
+
+    void enqueue(int i, int){ push_back(i); }
+    int pick_next(int){ return pop_first(); }
+    int timeslice(int, int now, int next_arrival){ return next_arrival - now; }
+    void on_preempt(int i, int){ push_front(i); }
+    int steal(int){ return pop_first(); }
+    void migrate_in(int i, int){ push_back(i); }
+};
+
+// Linux sched_prio_to_weight: nice -20..19 -> load weight, ~1.25x per step
+inline constexpr int nice_to_weight[40] = {
+ /* -20 */ 88761, 71755, 56483, 46273, 36291,
+ /* -15 */ 29154, 23254, 18705, 14949, 11916,
+ /* -10 */  9548,  7620,  6100,  4904,  3906,
+ /*  -5 */  3121,  2501,  1991,  1586,  1277,
+ /*   0 */  1024,   820,   655,   526,   423,
+ /*   5 */   335,   272,   215,   172,   137,
+ /*  10 */   110,    87,    70,    56,    45,
+ /*  15 */    36,    29,    23,    18,    15,
+};
+const int NICE_0_LOAD = 1024;
+
+// the priority field doubles as the nice value for the fair schedulers
+inline int nice_weight(int priority){
+    return nice_to_weight[std::min(std::max(priority, -20), 19) + 20];
+}
+
+// runtime -> virtual runtime (1/1024ths of a time unit), cf. calc_delta_fair
+inline long long calc_delta_fair(int delta, int weight){
+    return (long long)delta * NICE_0_LOAD * 1024 / weight;
+}
+
+// Fair-class scheduling entity (CFS / EEVDF), one per process in an array
+// shared by every CPU's runqueue; the tree node is embedded, so queueing
+// never allocates.
+struct FairEntity {
+    RbNode run_node;
+    long long vruntime = 0;     // virtual runtime, 1/1024ths of a time unit
+    long long deadline = 0;     // EEVDF virtual deadline
+    long long min_deadline = 0; // EEVDF: earliest deadline in run_node's subtree
+    int weight = NICE_0_LOAD;   // nice_weight(priority)
+    int slice = 1;              // EEVDF request size
+
+    static FairEntity* of(const RbNode* n){
+        return (FairEntity*)((const char*)n - offsetof(FairEntity, run_node));
+    }
+};
+
+inline std::vector<FairEntity> make_fair_entities(const ProcessTable& t){
+    std::vector<FairEntity> se(t.n);
+    for(int i=0;i<t.n;i++) se[i].weight = nice_weight(t.priority[i]);
+    return se;
+}
+
+// CFS: runnable processes ordered by vruntime in an intrusive red-black tree,
+// leftmost (least served) runs next. The slice is the process's weighted share
+// of the scheduling period; newly arrived processes are placed at min_vruntime
+// and wait for the current slice to end (no wakeup preemption).
+struct Cfs : Scheduler {
+    static FairEntity* of(const RbNode* n){ return FairEntity::of(n); }
+    struct ByVruntime {
+        bool operator()(const RbNode* a, const RbNode* b) const {
+            return of(a)->vruntime < of(b)->vruntime;
+        }
+    };
+
+    FairEntity* se;
+    RbTree<ByVruntime> tree;
+    int sched_latency;
+    int min_granularity;
+    long long load = 0;         // total weight of runnable + running processes
+    long long min_vruntime = 0; // monotonic floor used to place arrivals
+    int curr = -1;
+
+    Cfs(std::vector<FairEntity>& se, int sched_latency, int min_granularity)
+        :se(se.data()), sched_latency(sched_latency), min_granularity(min_granularity){}
+
+    bool empty() const { return tree.empty(); }
+    size_t size() const { return tree.size(); }
+
+    void enqueue(int i, int){
+        FairEntity &e = se[i];
+        e.vruntime = std::max(e.vruntime, min_vruntime);
+        load += e.weight;
+        tree.insert(&e.run_node);
+    }
+
+    int pick_next(int){
+        FairEntity* e = of(tree.first());
+        tree.erase(&e->run_node);
+        curr = e - se;
+        return curr;
+    }
+
+    // period stretches past sched_latency once more than latency/min_granularity
+    // processes are runnable, so every process still gets min_granularity
+    int timeslice(int i, int, int){
+        long long nr = tree.size() + 1;
+        long long period = sched_latency;
+        if(nr * min_granularity > period) period = nr * min_granularity;
+        long long slice = period * se[i].weight / load;
+        return (int)std::max<long long>(slice, min_granularity);
+    }
+
+    void on_tick(int i, int ran, int){
+        se[i].vruntime += calc_delta_fair(ran, se[i].weight);
+        update_min_vruntime();
+    }
+
+    void on_preempt(int i, int){
+        tree.insert(&se[i].run_node);
+        curr = -1;
+    }
+
+    void on_exit(int i, int){
+        load -= se[i].weight;
+        curr = -1;
+    }
+
+    // vruntime travels relative to min_vruntime, so a process neither gains
+    // nor loses service by moving to a runqueue with a different clock
+    int steal(int){
+        FairEntity* e = of(tree.first());
+        tree.erase(&e->run_node);
+        load -= e->weight;
+        e->vruntime -= min_vruntime;
+        return e - se;
+    }
+
+    void migrate_in(int i, int){
+        FairEntity &e = se[i];
+        e.vruntime += min_vruntime;
+        load += e.weight;
+        tree.insert(&e.run_node);
+    }
+
+    void update_min_vruntime(){
+        long long vr = curr >= 0 ? se[curr].vruntime : LLONG_MAX;
+        if(!tree.empty()) vr = std::min(vr, of(tree.first())->vruntime);
+        if(vr != LLONG_MAX) min_vruntime = std::max(min_vruntime, vr);
+    }
+};
+
+// EEVDF (Linux 6.6+): each process requests `slice` units and receives the
+// virtual deadline vruntime + slice/weight. A process is eligible when its
+// vruntime is not ahead of the load-weighted average V (lag >= 0); among
+// eligible processes the earliest virtual deadline runs. The runqueue is a
+// red-black tree ordered by vruntime and augmented with the minimum deadline
+// of each subtree, so the pick is O(log n). The request size (FairEntity::slice)
+// is the burst, optionally capped at max_slice (cf. the kernel clamping
+// sched_attr runtime).
+// An arrival can preempt the running process if it becomes the best pick.
+struct Eevdf : Scheduler {
+    static FairEntity* of(const RbNode* n){ return FairEntity::of(n); }
+    struct ByVruntime {
+        bool operator()(const RbNode* a, const RbNode* b) const {
+            return of(a)->vruntime < of(b)->vruntime;
+        }
+    };
+    struct MinDeadline {
+        static const bool enabled = true;
+        static void update(RbNode* n){
+            long long m = of(n)->deadline;
+            if(n->left) m = std::min(m, of(n->left)->min_deadline);
+            if(n->right) m = std::min(m, of(n->right)->min_deadline);
+            of(n)->min_deadline = m;
+        }
+    };
+
+    FairEntity* se;
+    RbTree<ByVruntime, MinDeadline> tree;
+    long long load = 0;     // total weight of runnable + running processes
+    __int128 weighted = 0;  // sum of weight * vruntime over the same set
+
+    explicit Eevdf(std::vector<FairEntity>& se):se(se.data()){}
+
+    bool empty() const { return tree.empty(); }
+    size_t size() const { return tree.size(); }
+
+    // weighted average vruntime V, rounded down
+    long long avg_vruntime() const {
+        if(load == 0) return 0;
+        __int128 v = weighted / load;
+        if(weighted < 0 && v * load != weighted) v--;
+        return (long long)v;
+    }
+
+    // vruntime <= V, compared without the division
+    bool eligible(const FairEntity& e) const {
+        return (__int128)e.vruntime * load <= weighted;
+    }
+
+    // a new process starts at V with zero lag; like PLACE_DEADLINE_INITIAL it
+    // gets half a slice so it is considered promptly
+    void enqueue(int i, int){
+        FairEntity &e = se[i];
+        e.vruntime = avg_vruntime();
+        e.deadline = e.vruntime + calc_delta_fair(e.slice, e.weight) / 2;
+        load += e.weight;
+        weighted += (__int128)e.weight * e.vruntime;
+        tree.insert(&e.run_node);
+    }
+
+    // Walk down from the root: an ineligible node rules out its right subtree
+    // (larger vruntime), an eligible node makes its whole left subtree
+    // eligible, so remember the best such subtree and only descend into it
+    // once its min_deadline is known to win.
+    RbNode* pick_eevdf() const {
+        RbNode *node = tree.root, *best = nullptr, *best_left = nullptr;
+        while(node){
+            if(!eligible(*of(node))){ node = node->left; continue; }
+            if(!best || of(node)->deadline < of(best)->deadline) best = node;
+            if(node->left && (!best_left || of(node->left)->min_deadline < of(best_left)->min_deadline))
+                best_left = node->left;
+            node = node->right;
+        }
+        if(best_left && of(best_left)->min_deadline < of(best)->deadline){
+            node = best_left;
+            long long target = of(node)->min_deadline;
+            while(of(node)->deadline != target){
+                if(node->left && of(node->left)->min_deadline == target) node = node->left;
+                else node = node->right;
+            }
+            best = node;
+        }
+        // the leftmost process always has lag >= 0, so best is only null if
+        // rounding ever disagreed; fall back to it
+        return best ? best : tree.first();
+    }
+
+    int pick_next(int){
+        RbNode* n = pick_eevdf();
+        tree.erase(n);
+        return of(n) - se;
+    }
+
+    // run until the virtual deadline is reached or the next arrival, which
+    // may be a better pick
+    int timeslice(int i, int now, int next_arrival){
+        const FairEntity &e = se[i];
+        long long scale = (long long)NICE_0_LOAD * 1024;
+        long long vleft = std::max(0LL, e.deadline - e.vruntime);
+        long long left = (vleft * e.weight + scale - 1) / scale;
+        return (int)std::min<long long>(left, next_arrival - (long long)now);
+    }
+
+    void on_tick(int i, int ran, int){
+        FairEntity &e = se[i];
+        long long dv = calc_delta_fair(ran, e.weight);
+        e.vruntime += dv;
+        weighted += (__int128)e.weight * dv;
+        if(e.vruntime >= e.deadline) e.deadline = e.vruntime + calc_delta_fair(e.slice, e.weight);
+    }
+
+    void on_preempt(int i, int){ tree.insert(&se[i].run_node); }
+
+    void on_exit(int i, int){
+        const FairEntity &e = se[i];
+        load -= e.weight;
+        weighted -= (__int128)e.weight * e.vruntime;
+    }
+
+    // vruntime and deadline travel relative to V, preserving lag
+    int steal(int now){
+        int i = of(tree.first()) - se;
+        FairEntity &e = se[i];
+        tree.erase(&e.run_node);
+        long long v = avg_vruntime();
+        on_exit(i, now);
+        e.vruntime -= v;
+        e.deadline -= v;
+        return i;
+    }
+
+    void migrate_in(int i, int){
+        FairEntity &e = se[i];
+        long long v = avg_vruntime();
+        e.vruntime += v;
+        e.deadline += v;
+        load += e.weight;
+        weighted += (__int128)e.weight * e.vruntime;
+        tree.insert(&e.run_node);
+    }
+};
+
+// Linux scheduling classes on one runqueue: SCHED_FIFO and SCHED_RR processes
+// (priority = rt_priority 1..99, higher first) on a priority array, and
+// SCHED_OTHER ones under CFS (priority = nice). The RT class is always asked
+// first, unless it is throttled: as with sched_rt_runtime_us and
+// sched_rt_period_us, RT processes may use at most rt_runtime of every
+// rt_period on a CPU (rt_runtime < 0: no limit). Once that is spent the class
+// sleeps until the period ends and fair processes, if any, run meanwhile.
+// RT arrivals and wakeups preempt fair processes and lower RT priorities at
+// once (wakeup_preempt); fair ones never cut a running slice, as in cfs. A
+// preempted RT process returns to the head of its level, and SCHED_RR keeps
+// the rest of its timeslice.
+struct ClassScheduler : Scheduler {
+    enum { OTHER = 0, FIFO = 1, RR = 2 }; // Linux policy numbers
+
+    PriorityArray rt;
+    Cfs fair;
+    const int* policy;
+    int* rr_left;                   // SCHED_RR: rest of the timeslice, per row
+    int rr_timeslice, rt_runtime, rt_period;
+    long long window = 0;           // current rt_period, as an index
+    int rt_used = 0;                // RT time spent in it
+    bool throttled = false;
+    int unthrottle = INT_MAX;       // end of the throttled period
+    long long throttles = 0;
+
+    ClassScheduler(const int* rt_level, PriorityArray::Links& links, std::vector<FairEntity>& se,
+                   const std::vector<int>& policy, std::vector<int>& rr_left, int rr_timeslice, int rt_runtime,
+                   int rt_period, int sched_latency, int min_granularity)
+        :rt(rt_level, links), fair(se, sched_latency, min_granularity), policy(policy.data()), rr_left(rr_left.data()),
+         rr_timeslice(rr_timeslice), rt_runtime(rt_runtime), rt_period(rt_period){}
+
+    bool is_rt(int i) const { return policy[i] != OTHER; }
+    bool rt_runnable() const { return !throttled && !rt.empty(); }
+
+    bool empty() const { return !rt_runnable() && fair.empty(); }
+    size_t size() const { return rt.size() + fair.size(); }
+
+    void enqueue(int i, int now){
+        if(!is_rt(i)) return fair.enqueue(i, now);
+        rr_left[i] = rr_timeslice;
+        rt.push_back(i);
+    }
+
+    int pick_next(int now){ return rt_runnable() ? rt.pop_first() : fair.pick_next(now); }
+
+    void start_window(int now){
+        if(now / rt_period != window){
+            window = now / rt_period;
+            rt_used = 0;
+        }
+    }
+
+    int timeslice(int i, int now, int next_arrival){
+        long long limit = INT_MAX;
+        if(throttled) limit = std::min<long long>(limit, unthrottle - now);
+        if(!is_rt(i)) return (int)std::min<long long>(limit, fair.timeslice(i, now, next_arrival));
+        if(rt_runtime >= 0){
+            start_window(now);
+            limit = std::min<long long>(limit, rt_runtime - rt_used);
+            limit = std::min(limit, (window + 1) * rt_period - now);
+        }
+        if(policy[i] == RR) limit = std::min<long long>(limit, rr_left[i]);
+        return (int)limit;
+    }
+
+    void on_tick(int i, int ran, int now){
+        if(!is_rt(i)) return fair.on_tick(i, ran, now);
+        if(policy[i] == RR) rr_left[i] -= ran;
+        if(rt_runtime < 0) return;
+        start_window(now - ran);
+        rt_used += ran;
+        if(rt_used >= rt_runtime){
+            throttled = true;
+            throttles++;
+            unthrottle = (int)std::min<long long>((window + 1) * rt_period, INT_MAX);
+        }
+    }
+
+    void on_preempt(int i, int now){
+        if(!is_rt(i)) return fair.on_preempt(i, now);
+        if(policy[i] == RR && rr_left[i] <= 0){
+            rr_left[i] = rr_timeslice;
+            rt.push_back(i);
+        } else {
+            rt.push_front(i);
+        }
+    }
+
+    void on_exit(int i, int now){ if(!is_rt(i)) fair.on_exit(i, now); }
+
+    bool wakeup_preempt(int i, int cur) const {
+        return is_rt(i) && !throttled && (!is_rt(cur) || rt.level(i) < rt.level(cur));
+    }
+
+    int next_timer() const { return throttled ? unthrottle : INT_MAX; }
+    void on_timer(int now){
+        throttled = false;
+        unthrottle = INT_MAX;
+        start_window(now);
+    }
+
+    // push RT processes to CPUs with room first, like RT push/pull
+    int steal(int now){ return !rt.empty() ? rt.pop_first() : fair.steal(now); }
+    void migrate_in(int i, int now){
+        if(is_rt(i)) rt.push_back(i);
+        else fair.migrate_in(i, now);
+    }
+};
+
+// Lottery: every quantum goes to the holder of a ticket drawn uniformly from
+// the queued processes' tickets (the priority's nice weight, as in CFS).
+// Ticket counts sit in a Fenwick tree over this CPU's slots, so a draw is one
+// O(log n) descent on the prefix sums; the running process holds no tickets
+// while it runs. A queued process takes a free slot (or appends one), so a
+// CPU's tree grows only to the most processes it ever held queued at once
+// rather than to the whole table. Each CPU draws from its own seeded
+// generator, so a run is reproducible.
+struct Lottery : Scheduler {
+    const int* tickets;
+    std::vector<long long> tree; // Fenwick tree over slots, 1-based
+    std::vector<int> row_of;     // slot -> table row
+    std::vector<int> free_slots;
+    int top_bit = 1;        // highest power of two <= slots
+    long long total = 0;    // queued tickets
+    size_t queued = 0;
+    int quantum;
+    std::mt19937_64 rng;
+
+    Lottery(const std::vector<int>& tickets, int quantum, uint64_t seed)
+        :tickets(tickets.data()), tree(1), quantum(quantum), rng(seed){}
+
+    long long prefix(int k) const {
+        long long s = 0;
+        for(;k>0;k-=k&-k) s += tree[k];
+        return s;
+    }
+
+    void add(int slot, long long delta){
+        for(int k=slot+1;k<(int)tree.size();k+=k&-k) tree[k] += delta;
+        total += delta;
+    }
+
+    // a slot to queue into: a freed one, or a new empty one at the end
+    int take_slot(){
+        if(!free_slots.empty()){
+            int slot = free_slots.back();
+            free_slots.pop_back();
+            return slot;
+        }
+        int k = tree.size();
+        tree.push_back(prefix(k - 1) - prefix(k - (k & -k)));
+        row_of.push_back(-1);
+        if(top_bit * 2 <= k) top_bit *= 2;
+        return k - 1;
+    }
+
+    int draw(){
+        // the first slot whose ticket prefix sum exceeds r
+        long long r = rng() % total;
+        int k = 0;
+        for(int step=top_bit;step;step>>=1){
+            if(k + step < (int)tree.size() && tree[k + step] <= r){
+                k += step;
+                r -= tree[k];
+            }
+        }
+        int i = row_of[k];
+        add(k, -tickets[i]);
+        free_slots.push_back(k);
+        queued--;
+        return i;
+    }
+
+    bool empty() const { return queued == 0; }
+    size_t size() const { return queued; }
+    void enqueue(int i, int){
+        int slot = take_slot();
+        row_of[slot] = i;
+        add(slot, tickets[i]);
+        queued++;
+    }
+    int pick_next(int){ return draw(); }
+    int timeslice(int, int, int){ return quantum; }
+    void on_preempt(int i, int now){ enqueue(i, now); }
+    int steal(int){ return draw(); }
+    void migrate_in(int i, int now){ enqueue(i, now); }
+};
+
+// Stride: a process's pass advances by STRIDE1 / tickets per unit of CPU time
+// and the lowest pass runs next for one quantum, so service tracks tickets
+// deterministically. A tick adds ran * STRIDE1 / tickets, dividing after the
+// multiply, so each tick is off by less than one pass unit however long it
+// ran. STRIDE1 = 2^32 keeps that product within 64 bits for any int run, and
+// a pass still fits for INT_MAX units of CPU time at the smallest weight
+// (15). Arrivals start at the runqueue's pass floor (the pass of the last
+// pick, like min_vruntime) and cannot claim service they missed.
+struct Stride : Scheduler {
+    static const long long STRIDE1 = 1LL << 32;
+    const int* tickets;
+    long long* pass; // per row, shared by every CPU
+    std::priority_queue<std::pair<long long,int>, std::vector<std::pair<long long,int>>, std::greater<std::pair<long long,int>>> pq;
+    long long min_pass = 0;
+    int quantum;
+
+    Stride(const std::vector<int>& tickets, std::vector<long long>& pass, int quantum)
+        :tickets(tickets.data()), pass(pass.data()), quantum(quantum){}
+
+    bool empty() const { return pq.empty(); }
+    size_t size() const { return pq.size(); }
+    void enqueue(int i, int){
+        pass[i] = std::max(pass[i], min_pass);
+        pq.push({pass[i], i});
+    }
+    int pick_next(int){
+        int i = pq.top().second; pq.pop();
+        min_pass = std::max(min_pass, pass[i]);
+        return i;
+    }
+    int timeslice(int, int, int){ return quantum; }
+    void on_tick(int i, int ran, int){ pass[i] += ran * STRIDE1 / tickets[i]; }
+    void on_preempt(int i, int){ pq.push({pass[i], i}); }
+    // pass travels relative to min_pass, as vruntime does in CFS
+    int steal(int){
+        int i = pq.top().second; pq.pop();
+        pass[i] -= min_pass;
+        return i;
+    }
+    void migrate_in(int i, int){
+        pass[i] += min_pass;
+        pq.push({pass[i], i});
+    }
+};
+
+} // namespace schedsim
@@ -0,0 +1,155 @@
+// schedsim/process.hpp - processes and the structure-of-arrays process table
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace schedsim {
+
+struct Process {
+    int pid;
+    int arrival;
+    int burst;
+    int priority; // lower number -> higher priority
+    int remaining;
+    int start_time;
+    int completion_time;
+    int waiting_time;
+    int turnaround_time;
+    int deadline;   // EDF: relative deadline, 0 = the period (or none)
+    int period;     // EDF: release period, 0 = a single job
+    int policy;     // mixed: SCHED_OTHER (0), SCHED_FIFO (1) or SCHED_RR (2)
+    int io_time;    // total time blocked in I/O
+    std::vector<int> bursts; // CPU, I/O, CPU, ... for a process that blocks; empty = burst alone
+    Process(int id=0,int a=0,int b=0,int p=0){
+        pid=id; arrival=a; burst=b; priority=p;
+        remaining=b; start_time=-1; completion_time=0;
+        waiting_time=0; turnaround_time=0;
+        deadline=0; period=0; policy=0; io_time=0;
+    }
+};
+
+// Structure-of-arrays copy of a process list for the scheduling loop. Hot
+// columns are touched on every dispatch or runqueue comparison, cold ones
+// only on first dispatch and completion. Built from a list already sorted
+// into admission order; store() writes the results back and derives
+// turnaround and waiting time from them. Stream mode instead starts from an
+// empty table of fixed capacity: admit() fills a free row and retire()
+// returns it, so the table only ever holds live processes.
+struct ProcessTable {
+    int n = 0;              // rows (capacity, in stream mode)
+    // hot
+    std::vector<int> remaining;
+    std::vector<int> priority;
+    std::vector<uint64_t> key;   // PPS order packed into one word, see pps_key()
+    // input
+    std::vector<int> pid, arrival, burst;
+    // cold
+    std::vector<int> start_time, completion_time;
+    std::vector<int> io;         // total I/O time
+    // rows that block: the (I/O, CPU) bursts after the first CPU burst, row
+    // i's still ahead at phases[next_phase[i] .. phase_end[i]); all empty
+    // when no row blocks
+    std::vector<int> phases, next_phase, phase_end;
+    std::vector<int> free_rows;  // stream mode: rows available to admit()
+
+    // (priority, arrival, pid) as (priority biased to unsigned) << 32 | index.
+    // The list is sorted by arrival, then priority, then pid, so among equal
+    // priorities index order is (arrival, pid) order and the index can be
+    // read back from the low half.
+    static uint64_t pps_key(int priority, int index){
+        return (uint64_t)((uint32_t)priority ^ 0x80000000u) << 32 | (uint32_t)index;
+    }
+
+    explicit ProcessTable(int capacity):n(capacity){
+        remaining.resize(n); priority.resize(n); key.resize(n);
+        pid.resize(n); arrival.resize(n); burst.resize(n);
+        start_time.resize(n); completion_time.resize(n); io.resize(n);
+        free_rows.reserve(n);
+        for(int i=n-1;i>=0;i--) free_rows.push_back(i);
+    }
+
+    explicit ProcessTable(const std::vector<Process>& procs):ProcessTable((int)procs.size()){
+        free_rows.clear();
+        for(int i=0;i<n;i++) set(i, procs[i]);
+        bool blocks = false;
+        for(auto &p: procs) blocks = blocks || !p.bursts.empty();
+        if(!blocks) return;
+        next_phase.resize(n); phase_end.resize(n);
+        for(int i=0;i<n;i++){
+            next_phase[i] = phases.size();
+            if(!procs[i].bursts.empty()) phases.insert(phases.end(), procs[i].bursts.begin() + 1, procs[i].bursts.end());
+            phase_end[i] = phases.size();
+        }
+    }
+
+    void set(int i, const Process& p){
+        remaining[i] = p.bursts.empty() ? p.remaining : p.bursts[0];
+        priority[i] = p.priority; key[i] = pps_key(p.priority, i);
+        pid[i] = p.pid; arrival[i] = p.arrival; burst[i] = p.burst;
+        start_time[i] = p.start_time; completion_time[i] = p.completion_time; io[i] = p.io_time;
+    }
+
+    // row i used up its CPU burst: the I/O time before the next one, whose
+    // length is now in remaining, or 0 when the row is done
+    int block(int i){
+        if(phases.empty() || next_phase[i] == phase_end[i]) return 0;
+        int k = next_phase[i];
+        next_phase[i] += 2;
+        remaining[i] = phases[k + 1];
+        return phases[k];
+    }
+
+    // row i with its results, as a Process
+    Process get(int i) const {
+        Process p(pid[i], arrival[i], burst[i], priority[i]);
+        p.remaining = remaining[i];
+        p.start_time = start_time[i]; p.completion_time = completion_time[i];
+        p.io_time = io[i];
+        p.turnaround_time = p.completion_time - p.arrival;
+        p.waiting_time = p.turnaround_time - p.burst - p.io_time;
+        return p;
+    }
+
+    // results only; the list keeps its input columns
+    void store(std::vector<Process>& procs) const {
+        for(int i=0;i<n;i++){
+            Process r = get(i);
+            Process &p = procs[i];
+            p.remaining = r.remaining;
+            p.start_time = r.start_time; p.completion_time = r.completion_time;
+            p.turnaround_time = r.turnaround_time; p.waiting_time = r.waiting_time;
+        }
+    }
+
+    bool full() const { return free_rows.empty(); }
+    int live() const { return n - (int)free_rows.size(); }
+
+    int admit(const Process& p){
+        int i = free_rows.back();
+        free_rows.pop_back();
+        set(i, p);
+        return i;
+    }
+
+    void retire(int i){ free_rows.push_back(i); }
+};
+
+struct GanttEntry {
+    int pid; int start; int end;
+    GanttEntry(int p,int s,int e):pid(p),start(s),end(e){}
+};
+
+// append a slice to the timeline, extending the last entry when the same pid
+// (or idle, pid -1) continues without a gap, so entries = context switches + 1
+inline void gantt_push(std::vector<GanttEntry>& gantt, int pid, int start, int end){
+    if(end <= start) return;
+    if(!gantt.empty() && gantt.back().pid == pid && gantt.back().end == start){
+        gantt.back().end = end;
+        return;
+    }
+    gantt.emplace_back(pid, start, end);
+}
+
+} // namespace schedsim
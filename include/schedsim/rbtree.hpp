@@ -0,0 +1,188 @@
+// schedsim/rbtree.hpp - intrusive red-black tree
+
+#pragma once
+
+#include <cstddef>
+
+namespace schedsim {
+
+// Intrusive red-black tree node (cf. Linux rb_node): embedded in the object
+// being ordered, so insertion and removal never allocate.
+struct RbNode {
+    RbNode *parent = nullptr, *left = nullptr, *right = nullptr;
+    bool red = false;
+};
+
+// Default augmentation: none. An augmented tree supplies update(n), which
+// recomputes n's cached subtree value from n and its children
+// (cf. rb_augment_callbacks).
+struct RbNoAugment {
+    static const bool enabled = false;
+    static void update(RbNode*){}
+};
+
+// Red-black tree over embedded RbNodes with a cached leftmost node
+// (cf. rb_root_cached). Less compares two nodes; equal keys go to the right,
+// so ties are served FIFO.
+template<class Less, class Aug = RbNoAugment>
+struct RbTree {
+    RbNode* root = nullptr;
+    RbNode* leftmost = nullptr;
+    size_t count = 0;
+    Less less;
+
+    explicit RbTree(Less l = Less()):less(l){}
+    bool empty() const { return root == nullptr; }
+    size_t size() const { return count; }
+    RbNode* first() const { return leftmost; }
+
+    void insert(RbNode* z){
+        RbNode* parent = nullptr;
+        RbNode** link = &root;
+        bool is_leftmost = true;
+        while(*link){
+            parent = *link;
+            if(less(z, parent)) link = &parent->left;
+            else { link = &parent->right; is_leftmost = false; }
+        }
+        z->parent = parent; z->left = z->right = nullptr; z->red = true;
+        *link = z;
+        if(is_leftmost) leftmost = z;
+        count++;
+        propagate(z);
+        insert_fixup(z);
+    }
+
+    void erase(RbNode* z){
+        if(leftmost == z) leftmost = next(z);
+        count--;
+        RbNode *y = z, *x, *xp;
+        bool removed_red = y->red;
+        if(!z->left){
+            x = z->right; xp = z->parent; transplant(z, z->right);
+        } else if(!z->right){
+            x = z->left; xp = z->parent; transplant(z, z->left);
+        } else {
+            y = z->right;
+            while(y->left) y = y->left;
+            removed_red = y->red;
+            x = y->right;
+            if(y->parent == z) xp = y;
+            else {
+                xp = y->parent;
+                transplant(y, y->right);
+                y->right = z->right; y->right->parent = y;
+            }
+            transplant(z, y);
+            y->left = z->left; y->left->parent = y;
+            y->red = z->red;
+        }
+        propagate(xp);
+        if(!removed_red) erase_fixup(x, xp);
+    }
+
+    static RbNode* next(RbNode* n){
+        if(n->right){
+            n = n->right;
+            while(n->left) n = n->left;
+            return n;
+        }
+        RbNode* p = n->parent;
+        while(p && n == p->right){ n = p; p = p->parent; }
+        return p;
+    }
+
+private:
+    static bool is_red(RbNode* n){ return n && n->red; }
+
+    // refresh augmented values from n up to the root
+    static void propagate(RbNode* n){
+        if constexpr (Aug::enabled) for(; n; n = n->parent) Aug::update(n);
+    }
+
+    void replace_child(RbNode* parent, RbNode* old, RbNode* node){
+        if(!parent) root = node;
+        else if(parent->left == old) parent->left = node;
+        else parent->right = node;
+    }
+
+    void transplant(RbNode* u, RbNode* v){
+        replace_child(u->parent, u, v);
+        if(v) v->parent = u->parent;
+    }
+
+    void rotate_left(RbNode* x){
+        RbNode* y = x->right;
+        x->right = y->left;
+        if(y->left) y->left->parent = x;
+        y->parent = x->parent;
+        replace_child(x->parent, x, y);
+        y->left = x; x->parent = y;
+        if constexpr (Aug::enabled){ Aug::update(x); Aug::update(y); }
+    }
+
+    void rotate_right(RbNode* x){
+        RbNode* y = x->left;
+        x->left = y->right;
+        if(y->right) y->right->parent = x;
+        y->parent = x->parent;
+        replace_child(x->parent, x, y);
+        y->right = x; x->parent = y;
+        if constexpr (Aug::enabled){ Aug::update(x); Aug::update(y); }
+    }
+
+    void insert_fixup(RbNode* z){
+        while(is_red(z->parent)){
+            RbNode* p = z->parent;
+            RbNode* g = p->parent; // exists: a red node is never the root
+            if(p == g->left){
+                RbNode* u = g->right;
+                if(is_red(u)){
+                    p->red = false; u->red = false; g->red = true; z = g;
+                } else {
+                    if(z == p->right){ z = p; rotate_left(z); p = z->parent; }
+                    p->red = false; g->red = true; rotate_right(g);
+                }
+            } else {
+                RbNode* u = g->left;
+                if(is_red(u)){
+                    p->red = false; u->red = false; g->red = true; z = g;
+                } else {
+                    if(z == p->left){ z = p; rotate_right(z); p = z->parent; }
+                    p->red = false; g->red = true; rotate_left(g);
+                }
+            }
+        }
+        root->red = false;
+    }
+
+    // x (possibly null) carries an extra black; xp is its parent
+    void erase_fixup(RbNode* x, RbNode* xp){
+        while(x != root && !is_red(x)){
+            if(x == xp->left){
+                RbNode* w = xp->right;
+                if(is_red(w)){ w->red = false; xp->red = true; rotate_left(xp); w = xp->right; }
+                if(!is_red(w->left) && !is_red(w->right)){
+                    w->red = true; x = xp; xp = x->parent;
+                } else {
+                    if(!is_red(w->right)){ w->left->red = false; w->red = true; rotate_right(w); w = xp->right; }
+                    w->red = xp->red; xp->red = false; w->right->red = false;
+                    rotate_left(xp); x = root;
+                }
+            } else {
+                RbNode* w = xp->left;
+                if(is_red(w)){ w->red = false; xp->red = true; rotate_right(xp); w = xp->left; }
+                if(!is_red(w->left) && !is_red(w->right)){
+                    w->red = true; x = xp; xp = x->parent;
+                } else {
+                    if(!is_red(w->left)){ w->right->red = false; w->red = true; rotate_left(w); w = xp->left; }
+                    w->red = xp->red; xp->red = false; w->left->red = false;
+                    rotate_right(xp); x = root;
+                }
+            }
+        }
+        if(x) x->red = false;
+    }
+};
+
+} // namespace schedsim
@@ -0,0 +1,110 @@
+// schedsim/report.hpp - metrics and text output
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "schedsim/process.hpp"
+#include "schedsim/schedule.hpp"
+
+namespace schedsim {
+
+// p50 / p90 / p99 / p99.9 / max of a histogram
+struct Percentiles {
+    long long p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+};
+
+Percentiles percentiles(const Histogram& h);
+
+// Summary numbers of one run
+struct Metrics {
+    int makespan = 0;
+    double avg_wt = 0, avg_tat = 0;
+    double avg_io = 0;              // time blocked in I/O
+    double cpu_util = 0;            // % of ncpu * makespan spent running
+    std::vector<double> cpu_util_per_cpu;
+    long long idle_time = 0;        // summed over CPUs, up to the makespan
+    double throughput = 0;          // processes per unit time
+    long long context_switches = 0;
+    int migrations = 0;
+    Percentiles wait, tat, resp;
+};
+
+Metrics compute_metrics(const Schedule& sched);
+
+void print_metrics(const Schedule& sched);
+
+// Bulk text output: fields are formatted with to_chars into one reusable
+// buffer that goes out with a single write(2) per 1 MiB chunk. Anything
+// pending in cout is flushed first so the two never interleave.
+struct OutBuf {
+    static const size_t CAP = 1 << 20;
+    int fd;
+    size_t len = 0;
+    std::unique_ptr<char[]> buf;
+
+    explicit OutBuf(int fd):fd(fd), buf(new char[CAP]){}
+    ~OutBuf(){ flush(); }
+
+    void begin(){ std::cout.flush(); }
+
+    void flush();
+
+    // write(2) a block straight to fd, bypassing buf
+    void write_all(const char* s, size_t n);
+
+    void reserve(size_t n){ if(len + n > CAP) flush(); }
+
+    void put(const char* s, size_t n){
+        if(n > CAP){ flush(); write_all(s, n); return; }
+        reserve(n);
+        std::memcpy(buf.get() + len, s, n);
+        len += n;
+    }
+    void put(const char* s){ put(s, std::strlen(s)); }
+    void put(char c){ reserve(1); buf[len++] = c; }
+
+    // integer right-aligned in `width` columns, like setw
+    void put_int(long long v, int width = 0){
+        char tmp[24];
+        char* e = std::to_chars(tmp, tmp + sizeof tmp, v).ptr;
+        int n = e - tmp;
+        reserve(std::max(n, width));
+        for(int i=n;i<width;i++) buf[len++] = ' ';
+        std::memcpy(buf.get() + len, tmp, n);
+        len += n;
+    }
+};
+
+OutBuf& stdout_buf();
+
+void print_gantt(const Schedule& sched);
+
+const char* const TABLE_HEADER = "\nPID  Arrival  Burst  Priority  Start  Completion  Waiting  Turnaround\n";
+
+void put_table_row(OutBuf& out, const Process& p);
+
+void print_table(const std::vector<Process>& procs);
+
+// options that control what a run writes, shared by every mode
+struct OutputConfig {
+    std::string gantt_out;          // also write the Gantt chart here as a binary trace
+    bool metrics_only = false; // skip the Gantt chart and per-process table
+    bool quiet = false;        // print nothing for the run (banner included)
+
+    // whether the run has to keep its timeline
+    bool needs_gantt() const { return !gantt_out.empty() || (!quiet && !metrics_only); }
+};
+
+// false if the --gantt-out trace could not be written
+bool print_report(const std::string& title, const std::vector<Process>& procs, const Schedule& sched,
+                  const OutputConfig& output);
+
+} // namespace schedsim
@@ -0,0 +1,16 @@
+// schedsim/schedsim.hpp - the whole library: policies, the discrete-event
+// core, per-mode runs, input/output formats, streaming and workload generation
+
+#pragma once
+
+#include "schedsim/gen.hpp"
+#include "schedsim/indexed_heap.hpp"
+#include "schedsim/io.hpp"
+#include "schedsim/modes.hpp"
+#include "schedsim/policies.hpp"
+#include "schedsim/process.hpp"
+#include "schedsim/rbtree.hpp"
+#include "schedsim/report.hpp"
+#include "schedsim/schedule.hpp"
+#include "schedsim/simulate.hpp"
+#include "schedsim/stream.hpp"
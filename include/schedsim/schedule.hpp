@@ -0,0 +1,203 @@
+// schedsim/schedule.hpp - run results: Gantt timeline, histograms and metric accumulators
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "schedsim/process.hpp"
+
+namespace schedsim {
+
+// Log-linear histogram of non-negative values in the style of HdrHistogram:
+// values below 2^SUB_BITS get a bucket each, every power-of-two range above
+// that is split into 2^(SUB_BITS-1) equal buckets, so a reported value is
+// within 1/128 of what was recorded. Recording is a shift and an increment;
+// histograms with the same layout merge by adding counts.
+struct Histogram {
+    static const int SUB_BITS = 8;
+    static const int HALF = 1 << (SUB_BITS - 1);
+    static const int BUCKETS = (64 - SUB_BITS) * HALF + (1 << SUB_BITS);
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    long long max_value = 0;
+
+    Histogram():counts(BUCKETS, 0){}
+
+    static int index(long long v){
+        if(v < (1 << SUB_BITS)) return (int)v;
+        int shift = 63 - __builtin_clzll(v) - (SUB_BITS - 1);
+        return shift * HALF + (int)(v >> shift);
+    }
+
+    // largest value that lands in bucket i
+    static long long highest(int i){
+        if(i < (1 << SUB_BITS)) return i;
+        int shift = i / HALF - 1;
+        long long sub = i - shift * HALF;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    void record(long long v){
+        v = std::max(0LL, v);
+        counts[index(v)]++;
+        total++;
+        max_value = std::max(max_value, v);
+    }
+
+    void merge(const Histogram& o){
+        for(int i=0;i<BUCKETS;i++) counts[i] += o.counts[i];
+        total += o.total;
+        max_value = std::max(max_value, o.max_value);
+    }
+
+    // smallest bucket value with at least p% of the samples at or below it
+    long long percentile(double p) const {
+        if(total == 0) return 0;
+        uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(p / 100.0 * total));
+        uint64_t seen = 0;
+        for(int i=0;i<BUCKETS;i++){
+            seen += counts[i];
+            if(seen >= rank) return std::min(highest(i), max_value);
+        }
+        return max_value;
+    }
+};
+
+// Summary counts kept up to date by simulate() at every slice and
+// completion, so metrics are exact without keeping the timeline. Slices are
+// counted the way gantt_push() would store them: a context switch is a
+// slice whose pid differs from the previous slice on the same CPU.
+struct MetricsAccumulator {
+    std::vector<long long> busy, idle; // per CPU
+    std::vector<int> last_pid;         // per CPU, INT_MIN before the first slice
+    std::vector<int> last_end;
+    long long context_switches = 0;
+    long long completed = 0;
+    long long sum_wt = 0, sum_tat = 0;
+    long long sum_io = 0;                     // time blocked in I/O
+    Histogram wait_hist, tat_hist, resp_hist; // response = first start - arrival
+    int makespan = 0;
+
+    void init(int ncpu){
+        busy.assign(ncpu, 0); idle.assign(ncpu, 0);
+        last_pid.assign(ncpu, INT_MIN); last_end.assign(ncpu, 0);
+    }
+
+    // pid -1 = idle
+    void slice(int c, int pid, int start, int end){
+        if(end <= start) return;
+        if(last_pid[c] != INT_MIN && last_pid[c] != pid) context_switches++;
+        (pid == -1 ? idle[c] : busy[c]) += end - start;
+        last_pid[c] = pid;
+        last_end[c] = end;
+        makespan = std::max(makespan, end);
+    }
+
+    // waiting = runnable but not running; io = blocked
+    void complete(int waiting, int turnaround, int response, int io){
+        completed++;
+        sum_wt += waiting;
+        sum_io += io;
+        sum_tat += turnaround;
+        wait_hist.record(waiting);
+        tat_hist.record(turnaround);
+        resp_hist.record(response);
+    }
+
+    // combine another run's counts (e.g. from another sweep worker); per-CPU
+    // times add up CPU by CPU
+    void merge(const MetricsAccumulator& o){
+        if(busy.size() < o.busy.size()){
+            busy.resize(o.busy.size(), 0); idle.resize(o.busy.size(), 0);
+            last_pid.resize(o.busy.size(), INT_MIN); last_end.resize(o.busy.size(), 0);
+        }
+        for(size_t c=0;c<o.busy.size();c++){ busy[c] += o.busy[c]; idle[c] += o.idle[c]; }
+        context_switches += o.context_switches;
+        completed += o.completed;
+        sum_wt += o.sum_wt;
+        sum_tat += o.sum_tat;
+        sum_io += o.sum_io;
+        wait_hist.merge(o.wait_hist);
+        tat_hist.merge(o.tat_hist);
+        resp_hist.merge(o.resp_hist);
+        makespan = std::max(makespan, o.makespan);
+    }
+
+    // CPUs that went quiet before the makespan were idle for the rest of it
+    void finish(){
+        for(size_t c=0;c<idle.size();c++) idle[c] += makespan - last_end[c];
+    }
+};
+
+// MLFQ occupancy of one level, summed over CPUs
+struct LevelStats {
+    int quantum = 0;
+    long long run_time = 0;    // CPU time spent running at this level
+    long long queued_time = 0; // process-time spent waiting at this level
+    long long demotions = 0;   // processes that dropped into this level
+};
+
+// EDF admission control and deadline outcome
+struct DeadlineStats {
+    int tasks = 0, admitted = 0;
+    std::vector<int> rejected;       // pids refused by admission control
+    double bandwidth = 0;           // sum of runtime/period over admitted tasks
+    double bound = 0;               // DL_BW_LIMIT per CPU
+    long long jobs = 0, misses = 0; // over jobs that have a deadline
+    long long sum_lateness = 0;     // lateness = completion - absolute deadline
+    long long min_lateness = 0, max_lateness = 0;
+    Histogram tardiness;            // max(0, lateness)
+
+    void job(long long lateness){
+        min_lateness = jobs ? std::min(min_lateness, lateness) : lateness;
+        max_lateness = jobs ? std::max(max_lateness, lateness) : lateness;
+        jobs++;
+        misses += lateness > 0;
+        sum_lateness += lateness;
+        tardiness.record(std::max(0LL, lateness));
+    }
+};
+
+// mixed: per scheduling class outcome
+struct ClassStats {
+    long long processes = 0;
+    long long cpu_time = 0;
+    long long sum_wait = 0, max_wait = 0;
+    long long sum_tat = 0;
+};
+
+// Proportional-share fairness: per process, lag = CPU time received minus
+// its ticket-weighted fair share over its lifetime (0 = exactly its share)
+struct ShareStats {
+    long long processes = 0; // 0 = not measured
+    double mean_abs_lag = 0;
+    double min_lag = 0, max_lag = 0;
+};
+
+// Outcome of a run: summary counts and, unless disabled, one Gantt timeline
+// per simulated CPU
+struct Schedule {
+    std::vector<std::vector<GanttEntry>> cpu;
+    MetricsAccumulator stats;
+    std::vector<LevelStats> levels; // MLFQ only
+    long long boosts = 0;      // MLFQ priority boosts
+    std::unique_ptr<DeadlineStats> deadlines; // EDF only
+    ShareStats shares;                   // lottery and stride only
+    std::vector<ClassStats> classes;          // mixed only, by policy number
+    long long rt_throttles = 0;          // mixed: periods in which RT was throttled
+    int migrations = 0; // processes moved between runqueues by the balancer
+    long long events = 0; // event times simulate() stopped at
+    std::string algorithm;   // mode name and parameters, recorded in binary traces
+    std::vector<int> params;
+    int makespan() const { return stats.makespan; }
+};
+
+} // namespace schedsim
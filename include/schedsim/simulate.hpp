@@ -0,0 +1,338 @@
+// schedsim/simulate.hpp - policy interface and the discrete-event core
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "schedsim/process.hpp"
+#include "schedsim/schedule.hpp"
+
+namespace schedsim {
+
+// Scheduling policy interface. A policy instance is one CPU's runqueue and is
+// driven by simulate():
+//   bool   empty()                        - nothing queued
+//   size_t size()                         - number of queued (not running) processes
+//   void   enqueue(int i, int now)        - process i arrived
+//   int    pick_next(int now)             - remove and return the process to run
+//   int    timeslice(int i, int now, int next_arrival)
+//                                         - how long i may run before the policy
+//                                           wants control back (clamped to remaining)
+//   void   on_tick(int i, int ran, int now) - i has just run for `ran` units
+//   void   on_preempt(int i, int now)     - i still has work, put it back
+//   void   on_exit(int i, int now)        - i completed
+//   int    steal(int now)                 - remove a queued process for migration
+//   void   migrate_in(int i, int now)     - accept a process stolen from another CPU
+// Policies derive from Scheduler for the optional hooks and are passed to
+// simulate() by type, so every call is resolved statically (no virtuals).
+struct Scheduler {
+    void on_tick(int, int, int){}
+    void on_exit(int, int){}
+    // a policy timer (RT throttling): its due time, INT_MAX when unarmed
+    int next_timer() const { return INT_MAX; }
+    void on_timer(int){}
+    // whether i, just enqueued, preempts the running process cur at once
+    // (cf. check_preempt_curr); otherwise cur keeps the rest of its slice
+    bool wakeup_preempt(int, int) const { return false; }
+};
+
+// multi-CPU settings shared by every mode
+struct SmpConfig {
+    int cpus = 1;
+    int balance_interval = 4; // period of the periodic load balancer
+};
+
+// Arrival sources for simulate():
+//   int  next_arrival() - time of the next arrival, INT_MAX when there is none
+//   int  admit()        - table row of that arrival, now runnable
+//   void retire(int i)  - i completed (completion_time set) and left its runqueue
+// TableArrivals walks a table sorted into admission order; stream mode reads
+// arrivals as simulated time reaches them (StreamArrivals).
+struct TableArrivals {
+    const ProcessTable& t;
+    int idx = 0; // next process to arrive
+    explicit TableArrivals(const ProcessTable& t):t(t){}
+    int next_arrival() const { return idx < t.n ? t.arrival[idx] : INT_MAX; }
+    int admit(){ return idx++; }
+    void retire(int){}
+};
+
+// Load index over the CPUs for simulate(): a tournament tree whose nodes hold,
+// for their range of CPUs, the least loaded CPU (by nr_running), the busiest
+// CPU with work queued and the CPU with the longest runqueue, ties going to
+// the lowest CPU id as a scan in CPU order would. set() is O(log cpus), the
+// queries O(1).
+struct CpuLoads {
+    int leaves = 1;
+    std::vector<int> nr, queued;    // per CPU; queued < 0: nothing runnable queued
+    std::vector<int> lo, hi, longest; // per node, -1 = none
+
+    explicit CpuLoads(int ncpu):nr(ncpu, 0), queued(ncpu, -1){
+        while(leaves < ncpu) leaves *= 2;
+        lo.assign(2 * leaves, -1); hi.assign(2 * leaves, -1); longest.assign(2 * leaves, -1);
+        for(int c=0;c<ncpu;c++) lo[leaves + c] = c;
+        for(int k=leaves-1;k>0;k--) pull(k);
+    }
+
+    void pull(int k){
+        int a = lo[2*k], b = lo[2*k+1];
+        lo[k] = b >= 0 && (a < 0 || nr[b] < nr[a]) ? b : a;
+        a = hi[2*k]; b = hi[2*k+1];
+        hi[k] = b >= 0 && (a < 0 || nr[b] > nr[a]) ? b : a;
+        a = longest[2*k]; b = longest[2*k+1];
+        longest[k] = b >= 0 && (a < 0 || queued[b] > queued[a]) ? b : a;
+    }
+
+    // CPU c runs nr processes (queued included); queued as above
+    void set(int c, int nr_c, int queued_c){
+        if(nr[c] == nr_c && queued[c] == queued_c) return;
+        nr[c] = nr_c; queued[c] = queued_c;
+        int k = leaves + c;
+        hi[k] = longest[k] = queued_c >= 0 ? c : -1;
+        for(k/=2;k>0;k/=2) pull(k);
+    }
+
+    int least_loaded() const { return lo[1]; }
+    int busiest() const { return hi[1]; }
+    int longest_queue() const { return longest[1]; }
+};
+
+// Shared discrete-event core: rqs holds one policy instance per CPU and
+// arrivals come from `arrivals` in admission order. A process whose CPU burst
+// ends with more bursts ahead leaves its runqueue (on_exit) and sleeps on the
+// wait queue for its I/O time, then wakes like an arrival (enqueue). Metrics
+// are accumulated as the run goes; with record_gantt unset no timeline is
+// kept, so memory is independent of the length of the run.
+// Time jumps straight to the next event: an arrival, a wakeup, the end of a
+// granted slice, a policy timer, or (with several CPUs and queued work) a
+// periodic balance tick. At each event, in order:
+//   1. slices ending now are charged to their policies and due policy
+//      timers fire;
+//   2. arrivals, then wakeups, are placed on the CPU with the fewest runnable
+//      processes, whose running process is first charged for the time it
+//      has run and, if the policy's wakeup_preempt() says so, preempted;
+//   3. the preempted processes are handed back to their own runqueue (so, as
+//      on one CPU, arrivals during a slice queue ahead of it), put to sleep
+//      or completed;
+//   4. on a balance tick, processes are pulled from the busiest to the least
+//      loaded CPU until they differ by at most one;
+//   5. each idle CPU with an empty runqueue pulls one waiting process from
+//      the busiest runqueue (newidle balance), then idle CPUs dispatch.
+// Per-CPU state that the steps search is indexed so an event costs
+// O(log cpus) per CPU it touches rather than a scan of every CPU: loads and
+// queue lengths in CpuLoads, idle CPUs in a bitmap, and policy timers (only
+// for policies that define next_timer) in a min-heap with stale entries
+// skipped.
+template<class Sched, class Arrivals>
+Schedule simulate(ProcessTable& t, Arrivals& arrivals, std::vector<Sched>& rqs, const SmpConfig& smp,
+                  bool record_gantt){
+    int ncpu = rqs.size();
+    int live = 0; // admitted, not yet completed
+    Schedule out;
+    out.cpu.assign(ncpu, {});
+    out.stats.init(ncpu);
+    std::vector<int> curr(ncpu, -1), slice_start(ncpu, 0), idle_since(ncpu, 0);
+    // pending slice ends, earliest first (ties by CPU id)
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> slice_end;
+    // wait queue: (wakeup time, row) of the processes blocked in I/O
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> wakeups;
+    std::vector<int> finished; // CPUs whose slice ended at the current event
+    // end of each CPU's slice in slice_end, -1 once it ended; entries that no
+    // longer match were cut short by wakeup_preempt and are skipped
+    std::vector<int> slice_until(ncpu, -1);
+    auto next_slice_end = [&](){
+        while(!slice_end.empty() && slice_until[slice_end.top().second] != slice_end.top().first) slice_end.pop();
+        return slice_end.empty() ? INT_MAX : slice_end.top().first;
+    };
+    constexpr bool preempts = !std::is_same_v<decltype(&Sched::wakeup_preempt), bool (Scheduler::*)(int, int) const>;
+
+    constexpr bool timers = !std::is_same_v<decltype(&Sched::next_timer), int (Scheduler::*)() const>;
+    std::vector<int> timer(ncpu, INT_MAX);
+    // (due time, CPU); an entry is current while timer[CPU] still matches it
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> timers_due;
+    CpuLoads loads(ncpu);
+    std::vector<uint64_t> idle((ncpu + 63) / 64, 0);
+    for(int c=0;c<ncpu;c++) idle[c >> 6] |= 1ULL << (c & 63);
+
+    // first idle CPU >= c, or ncpu
+    auto next_idle = [&](int c){
+        for(int w = c >> 6; w < (int)idle.size(); w++){
+            uint64_t bits = idle[w] & (~0ULL << (c & 63));
+            if(bits) return w * 64 + __builtin_ctzll(bits);
+            c = (w + 1) * 64;
+        }
+        return ncpu;
+    };
+    auto nr_running = [&](int c){ return (int)rqs[c].size() + (curr[c] >= 0); };
+    // re-read CPU c's load and timer after anything that may change them
+    auto update = [&](int c){
+        loads.set(c, nr_running(c), rqs[c].empty() ? -1 : (int)rqs[c].size());
+        if constexpr (timers){
+            int due = rqs[c].next_timer();
+            if(due != timer[c]){
+                timer[c] = due;
+                if(due != INT_MAX) timers_due.push({due, c});
+            }
+        }
+    };
+    auto next_timer = [&](){
+        while(!timers_due.empty() && timer[timers_due.top().second] != timers_due.top().first) timers_due.pop();
+        return timers_due.empty() ? INT_MAX : timers_due.top().first;
+    };
+    auto migrate = [&](int from, int to, int time){
+        rqs[to].migrate_in(rqs[from].steal(time), time);
+        out.migrations++;
+        update(from);
+        update(to);
+    };
+    // bring the running process's accounting up to `time` (cf. update_curr)
+    auto charge = [&](int c, int time){
+        int cur = curr[c];
+        if(cur < 0 || time == slice_start[c]) return;
+        int ran = time - slice_start[c];
+        out.stats.slice(c, t.pid[cur], slice_start[c], time);
+        if(record_gantt) gantt_push(out.cpu[c], t.pid[cur], slice_start[c], time);
+        t.remaining[cur] -= ran;
+        slice_start[c] = time;
+        rqs[c].on_tick(cur, ran, time);
+        update(c);
+    };
+
+    int time = 0;
+    int next_balance = smp.balance_interval;
+    while(true){
+        // 1. charge the slices that end now
+        finished.clear();
+        while(next_slice_end() == time){
+            int c = slice_end.top().second; slice_end.pop();
+            slice_until[c] = -1;
+            charge(c, time);
+            finished.push_back(c);
+        }
+        if constexpr (timers){
+            // each due CPU once, in CPU order
+            std::vector<int> due;
+            while(next_timer() <= time){
+                due.push_back(timers_due.top().second);
+                timers_due.pop();
+            }
+            std::sort(due.begin(), due.end());
+            for(int c: due){
+                timer[c] = INT_MAX;
+                rqs[c].on_timer(time);
+                update(c);
+            }
+        }
+
+        // 2. admit arrivals, wake sleepers
+        auto place = [&](int i){
+            int target = loads.least_loaded();
+            charge(target, time);
+            rqs[target].enqueue(i, time);
+            if constexpr (preempts){
+                int cur = curr[target];
+                if(cur >= 0 && slice_until[target] > time && rqs[target].wakeup_preempt(i, cur)){
+                    slice_until[target] = -1;
+                    finished.push_back(target);
+                }
+            }
+            update(target);
+        };
+        while(arrivals.next_arrival() <= time){
+            place(arrivals.admit());
+            live++;
+        }
+        while(!wakeups.empty() && wakeups.top().first <= time){
+            place(wakeups.top().second);
+            wakeups.pop();
+        }
+
+        // 3. requeue or retire what just ran
+        for(int c: finished){
+            int cur = curr[c];
+            curr[c] = -1;
+            idle[c >> 6] |= 1ULL << (c & 63);
+            idle_since[c] = time;
+            if(t.remaining[cur] > 0){
+                rqs[c].on_preempt(cur, time);
+                update(c);
+                continue;
+            }
+            rqs[c].on_exit(cur, time);
+            update(c);
+            if(int io = t.block(cur)){
+                wakeups.push({(int)std::min<long long>((long long)time + io, INT_MAX), cur});
+                continue;
+            }
+            t.completion_time[cur] = time;
+            int turnaround = time - t.arrival[cur];
+            out.stats.complete(turnaround - t.burst[cur] - t.io[cur], turnaround, t.start_time[cur] - t.arrival[cur],
+                               t.io[cur]);
+            live--;
+            arrivals.retire(cur);
+        }
+        int next_arrival = arrivals.next_arrival();
+        // policies see a wakeup as an arrival (a point where they may preempt)
+        if(!wakeups.empty()) next_arrival = std::min(next_arrival, wakeups.top().first);
+        if(live == 0 && next_arrival == INT_MAX) break;
+
+        // 4. periodic load balance
+        if(ncpu > 1 && time >= next_balance){
+            while(true){
+                int hi = loads.busiest(), lo = loads.least_loaded();
+                if(hi < 0 || loads.nr[hi] - loads.nr[lo] < 2) break;
+                migrate(hi, lo, time);
+            }
+            next_balance = (time / smp.balance_interval + 1) * smp.balance_interval;
+        }
+
+        // 5. newidle balance and dispatch
+        // idle CPUs in order, while anything is queued anywhere
+        for(int c = next_idle(0); c < ncpu && loads.longest_queue() >= 0; c = next_idle(c + 1)){
+            if(rqs[c].empty() && ncpu > 1){
+                int b = loads.longest_queue();
+                if(curr[b] >= 0 || rqs[b].size() > 1) migrate(b, c, time);
+            }
+            if(rqs[c].empty()) continue;
+            int cur = rqs[c].pick_next(time);
+            if(t.start_time[cur] == -1) t.start_time[cur] = time;
+            int run_for = std::min(std::max(1, rqs[c].timeslice(cur, time, next_arrival)), t.remaining[cur]);
+            out.stats.slice(c, -1, idle_since[c], time);
+            if(record_gantt) gantt_push(out.cpu[c], -1, idle_since[c], time);
+            curr[c] = cur;
+            idle[c >> 6] &= ~(1ULL << (c & 63));
+            slice_start[c] = time;
+            slice_until[c] = time + run_for;
+            slice_end.push({time + run_for, c});
+            update(c);
+        }
+
+        // advance to the next event
+        int next = next_arrival;
+        next = std::min(next, next_slice_end());
+        if constexpr (timers) next = std::min(next, next_timer());
+        if(ncpu > 1 && loads.longest_queue() >= 0) next = std::min(next, next_balance);
+        if(next == INT_MAX) break;
+        time = next;
+        out.events++;
+    }
+    out.stats.finish();
+    return out;
+}
+
+// whole-table run, the table sorted into admission order
+template<class Sched>
+Schedule simulate(ProcessTable& t, std::vector<Sched>& rqs, const SmpConfig& smp = SmpConfig(),
+                  bool record_gantt = true){
+    TableArrivals arrivals(t);
+    return simulate(t, arrivals, rqs, smp, record_gantt);
+}
+
+} // namespace schedsim
@@ -0,0 +1,21 @@
+// schedsim/stream.hpp - bounded-memory simulation of an arrival stream
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "schedsim/report.hpp"
+#include "schedsim/simulate.hpp"
+
+namespace schedsim {
+
+// stream rr [quantum] | pps | cfs [lat] [gran] | eevdf [max_slice]: arrivals
+// in time order from --input or stdin, memory bounded by max_live live
+// processes. PPS runs on the O(1) priority array, whose FIFO levels keep
+// (arrival, pid) order without a key that encodes admission order; results
+// match batch pps-o1, and batch pps only on one CPU.
+int stream(const std::vector<std::string>& args, const std::string& input_path, int max_live, const SmpConfig& smp,
+           const OutputConfig& output);
+
+} // namespace schedsim
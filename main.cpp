@@ -1,231 +1,23 @@
 // main.cpp
-// Linux-Based Process Scheduler Simulation
-// Supports: Round Robin (RR) and Preemptive Priority Scheduling (PPS)
-// Compile: g++ -std=c++17 -O2 main.cpp -o scheduler
+// Linux-Based Process Scheduler Simulation: command line front end of the
+// schedsim library (modes, options, input loading)
+// Build: cmake -S . -B build && cmake --build build (see README.md)
 
-#include <bits/stdc++.h>
-using namespace std;
-
-struct Process {
-    int pid;
-    int arrival;
-    int burst;
-    int priority; // lower number -> higher priority
-    int remaining;
-    int start_time;
-    int completion_time;
-    int waiting_time;
-    int turnaround_time;
-    Process(int id=0,int a=0,int b=0,int p=0){
-        pid=id; arrival=a; burst=b; priority=p;
-        remaining=b; start_time=-1; completion_time=0;
-        waiting_time=0; turnaround_time=0;
-    }
-};
-
-struct GanttEntry {
-    int pid; int start; int end;
-    GanttEntry(int p,int s,int e):pid(p),start(s),end(e){}
-};
-
-void print_metrics(const vector<Process>& procs, const vector<GanttEntry>& gantt, int total_time){
-    int n = procs.size();
-    double sum_wt=0, sum_tat=0;
-    for(auto &p: procs){
-        sum_wt += p.waiting_time;
-        sum_tat += p.turnaround_time;
-    }
-    double avg_wt = sum_wt/n;
-    double avg_tat = sum_tat/n;
-    int cpu_busy=0;
-    for(auto &g: gantt) if(g.pid!=-1) cpu_busy += (g.end - g.start);
-    double cpu_util = 100.0 * cpu_busy / (double) total_time;
-    double throughput = (double)n / total_time;
-    int context_switches = 0;
-    for(size_t i=1;i<gantt.size();++i) if(gantt[i].pid != gantt[i-1].pid) context_switches++;
-
-    cout << fixed << setprecision(2);
-    cout << "\n--- Metrics ---\n";
-    cout << "Total time (makespan): " << total_time << "\n";
-    cout << "Average Waiting Time : " << avg_wt << "\n";
-    cout << "Average Turnaround Time : " << avg_tat << "\n";
-    cout << "CPU Utilization: " << cpu_util << " %\n";
-    cout << "Throughput (processes/unit time): " << throughput << "\n";
-    cout << "Context switches (approx): " << context_switches << "\n";
-}
-
-void print_gantt(const vector<GanttEntry>& gantt){
-    cout << "\nGantt Chart (pid : [start -> end])\n";
-    for(auto &g: gantt){
-        if(g.pid == -1) cout << "idle" << " : [" << g.start << " -> " << g.end << "]  ";
-        else cout << "P" << g.pid << " : [" << g.start << " -> " << g.end << "]  ";
-    }
-    cout << "\n";
-}
-
-// Round Robin (quantum) - preemptive by design
-void round_robin(vector<Process> procs, int quantum){
-    cout << "\n=== Round Robin (quantum = " << quantum << ") ===\n";
-    int n = procs.size();
-    // sort by arrival then pid
-    sort(procs.begin(), procs.end(), [](const Process& a, const Process& b){
-        if(a.arrival!=b.arrival) return a.arrival < b.arrival;
-        return a.pid < b.pid;
-    });
-
-    queue<int> q; // indices into procs
-    vector<bool> in_queue(n,false);
-    int time = 0;
-    int completed = 0;
-    vector<GanttEntry> gantt;
-
-    // push initial arrivals at time 0
-    for(int i=0;i<n && procs[i].arrival==0;i++){
-        q.push(i); in_queue[i]=true;
-    }
-    int idx_next_arrival = 0;
-    while(idx_next_arrival < n && procs[idx_next_arrival].arrival==0) idx_next_arrival++;
-
-    // if no process arrived at time 0, fast-forward to first arrival (idle)
-    if(q.empty() && idx_next_arrival < n){
-        int next_t = procs[idx_next_arrival].arrival;
-        gantt.emplace_back(-1, time, next_t);
-        time = next_t;
-        while(idx_next_arrival < n && procs[idx_next_arrival].arrival==time){
-            q.push(idx_next_arrival); in_queue[idx_next_arrival]=true; idx_next_arrival++;
-        }
-    }
-
-    while(completed < n){
-        if(q.empty()){
-            if(idx_next_arrival < n){
-                int next_t = procs[idx_next_arrival].arrival;
-                if(time < next_t){
-                    gantt.emplace_back(-1, time, next_t);
-                    time = next_t;
-                }
-                while(idx_next_arrival < n && procs[idx_next_arrival].arrival==time){
-                    q.push(idx_next_arrival); in_queue[idx_next_arrival]=true; idx_next_arrival++;
-                }
-                continue;
-            }
-            break;
-        }
-
-        int i = q.front(); q.pop(); in_queue[i]=false;
-        Process &p = procs[i];
-        if(p.start_time == -1) p.start_time = time;
-        int exec = min(quantum, p.remaining);
-        gantt.emplace_back(p.pid, time, time+exec);
-        p.remaining -= exec;
-        // advance time and add arrivals that come while running this quantum
-        int old_time = time;
-        time += exec;
-        while(idx_next_arrival < n && procs[idx_next_arrival].arrival <= time){
-            q.push(idx_next_arrival); in_queue[idx_next_arrival]=true; idx_next_arrival++;
-        }
-        if(p.remaining > 0){
-            q.push(i); in_queue[i]=true;
-        } else {
-            p.completion_time = time;
-            p.turnaround_time = p.completion_time - p.arrival;
-            p.waiting_time = p.turnaround_time - p.burst;
-            completed++;
-        }
-    }
-
-    // finalize metrics: copy back waiting/turnaround to a vector for printing
-    // Procs vector already has it
-    print_gantt(gantt);
-    print_metrics(procs, gantt, gantt.empty() ? 0 : gantt.back().end);
-
-    // print table
-    cout << "\nPID  Arrival  Burst  Priority  Start  Completion  Waiting  Turnaround\n";
-    for(auto &p: procs){
-        cout << setw(3) << p.pid << setw(9) << p.arrival << setw(7) << p.burst
-             << setw(9) << p.priority << setw(7) << p.start_time << setw(11) << p.completion_time
-             << setw(9) << p.waiting_time << setw(11) << p.turnaround_time << "\n";
-    }
-}
-
-// Preemptive Priority Scheduling (smaller priority value => higher priority)
-void preemptive_priority(vector<Process> procs){
-    cout << "\n=== Preemptive Priority Scheduling (lower - higher priority) ===\n";
-    int n = procs.size();
-    sort(procs.begin(), procs.end(), [](const Process& a, const Process& b){
-        if(a.arrival!=b.arrival) return a.arrival < b.arrival;
-        if(a.priority!=b.priority) return a.priority < b.priority;
-        return a.pid < b.pid;
-    });
-
-    int time = 0;
-    int completed = 0;
-    int idx = 0;
-    // min-heap by priority then arrival then pid
-    auto cmp = [&](int a, int b){
-        if(procs[a].priority != procs[b].priority) return procs[a].priority > procs[b].priority;
-        if(procs[a].arrival != procs[b].arrival) return procs[a].arrival > procs[b].arrival;
-        return procs[a].pid > procs[b].pid;
-    };
-    priority_queue<int, vector<int>, decltype(cmp)> pq(cmp);
-    vector<GanttEntry> gantt;
-
-    // advance to first arrival if needed
-    if(idx < n && procs[idx].arrival > time){
-        gantt.emplace_back(-1, time, procs[idx].arrival);
-        time = procs[idx].arrival;
-    }
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
-    while(completed < n){
-        while(idx < n && procs[idx].arrival <= time){
-            pq.push(idx); idx++;
-        }
-
-        if(pq.empty()){
-            if(idx < n){
-                int next_t = procs[idx].arrival;
-                if(time < next_t){
-                    gantt.emplace_back(-1, time, next_t);
-                    time = next_t;
-                }
-                continue;
-            }
-            break;
-        }
-
-        int cur = pq.top(); pq.pop();
-        Process &p = procs[cur];
-        if(p.start_time == -1) p.start_time = time;
-        // run for 1 unit (time quantum of 1) to allow preemption checks
-        int run_for = 1;
-        gantt.emplace_back(p.pid, time, time+run_for);
-        p.remaining -= run_for;
-        time += run_for;
-
-        // push any new arrivals that come at this time
-        while(idx < n && procs[idx].arrival <= time){
-            pq.push(idx); idx++;
-        }
-
-        if(p.remaining > 0){
-            pq.push(cur); // still has remaining, may be preempted by higher priority
-        } else {
-            p.completion_time = time;
-            p.turnaround_time = p.completion_time - p.arrival;
-            p.waiting_time = p.turnaround_time - p.burst;
-            completed++;
-        }
-    }
+#include "schedsim/schedsim.hpp"
 
-    print_gantt(gantt);
-    print_metrics(procs, gantt, gantt.empty() ? 0 : gantt.back().end);
-    cout << "\nPID  Arrival  Burst  Priority  Start  Completion  Waiting  Turnaround\n";
-    for(auto &p: procs){
-        cout << setw(3) << p.pid << setw(9) << p.arrival << setw(7) << p.burst
-             << setw(9) << p.priority << setw(7) << p.start_time << setw(11) << p.completion_time
-             << setw(9) << p.waiting_time << setw(11) << p.turnaround_time << "\n";
-    }
-}
+using namespace std;
+using namespace schedsim;
 
 vector<Process> load_sample(){ // a small helper that creates sample processes
     // You can replace these or read from file as shown in README
@@ -241,37 +33,272 @@ int main(int argc, char** argv){
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
 
-    cout << "Linux-Based Process Scheduler Simulation\n";
-    cout << "Usage: ./scheduler [mode] [quantum]\n";
-    cout << "Modes: rr (Round Robin), pps (Preemptive Priority Scheduling)\n";
-    cout << "If no args provided, sample dataset will run both algorithms.\n";
+    // split "--option value" pairs from the positional [mode] [args]
+    SmpConfig smp;
+    OutputConfig output;
+    int threads = max(1u, thread::hardware_concurrency());
+    int max_live = 1 << 16;
+    int trace_unit = 1;
+    string input_path;
+    vector<string> args;
+    for(int i=1;i<argc;i++){
+        string a = argv[i];
+        if(a == "--metrics-only"){
+            output.metrics_only = true;
+        } else if(a == "--quiet"){
+            output.quiet = true;
+        } else if(a == "--input"){
+            if(i+1 >= argc){
+                cerr << a << " expects a file name\n";
+                return 1;
+            }
+            input_path = argv[++i];
+        } else if(a == "--gantt-out"){
+            if(i+1 >= argc){
+                cerr << a << " expects a file name\n";
+                return 1;
+            }
+            output.gantt_out = argv[++i];
+        } else if(a == "--cpus" || a == "--balance-interval" || a == "--threads" || a == "--max-live"
+                  || a == "--trace-unit"){
+            if(i+1 >= argc){
+                cerr << a << " expects a value\n";
+                return 1;
+            }
+            long long v;
+            if(!parse_int(argv[++i], v)){
+                cerr << a << " expects an integer\n";
+                return 1;
+            }
+            if(v < 1){
+                cerr << a << " must be positive\n";
+                return 1;
+            }
+            if(v > INT_MAX){
+                cerr << a << " out of range\n";
+                return 1;
+            }
+            (a == "--cpus" ? smp.cpus : a == "--threads" ? threads : a == "--max-live" ? max_live
+             : a == "--trace-unit" ? trace_unit : smp.balance_interval) = (int)v;
+        } else {
+            args.push_back(a);
+        }
+    }
+
+    if(!args.empty() && args[0] == "convert"){
+        if(args.size() != 4){
+            cerr << "usage: convert text2bin|bin2text|trace2text IN OUT\n";
+            return 1;
+        }
+        return convert(args[1], args[2], args[3], trace_unit);
+    }
+
+    if(!args.empty() && args[0] == "gen") return gen(args, threads);
+
+    if(!output.quiet){
+        cout << "Linux-Based Process Scheduler Simulation\n";
+        cout << "Usage: ./scheduler [mode] [args]\n";
+        cout << "Modes: rr [quantum] (Round Robin), pps (Preemptive Priority Scheduling),\n";
+        cout << "       sjf (Shortest Job First), srtf (Shortest Remaining Time First),\n";
+        cout << "       edf [horizon] (Earliest Deadline First; input adds deadline period columns),\n";
+        cout << "       pps-o1 (PPS on an O(1) bitmap priority array),\n";
+        cout << "       cfs [sched_latency] [min_granularity] (Completely Fair Scheduler),\n";
+        cout << "       eevdf [max_slice] (Earliest Eligible Virtual Deadline First),\n";
+        cout << "       mixed [rr_timeslice] [rt_runtime] [rt_period] [sched_latency] [min_granularity]\n";
+        cout << "             (SCHED_FIFO/RR/OTHER by a policy column),\n";
+        cout << "       lottery [quantum] [seed], stride [quantum] (proportional share, tickets from priority),\n";
+        cout << "       mlfq [levels] [quantum|q0,q1,..] [boost] (Multi-Level Feedback Queue),\n";
+        cout << "       sweep [qmin] [qmax] [qstep] (RR over a quantum range plus PPS, in parallel),\n";
+        cout << "       stream rr|pps|cfs|eevdf [args] (time-ordered arrivals, bounded memory)\n";
+        cout << "Options: --cpus N (simulated CPUs), --balance-interval T (load balance period),\n";
+        cout << "         --input FILE (text or binary process list, or sched event dump, instead of stdin),\n";
+        cout << "         --trace-unit US (microseconds per time unit when reading a sched dump, default 1),\n";
+        cout << "         --gantt-out FILE (also write the Gantt chart as a binary trace),\n";
+        cout << "         --threads N (sweep and gen workers, default: hardware threads),\n";
+        cout << "         --max-live N (stream: live process capacity, default 65536),\n";
+        cout << "         --metrics-only (skip Gantt chart and process table), --quiet (print nothing)\n";
+        cout << "Convert: convert text2bin|bin2text|trace2text IN OUT\n";
+        cout << "Generate: gen N [arrival=poisson:RATE|mmpp:R0,R1,S01,S10] [burst=exp:MEAN|lognormal:MU,SIGMA|\n";
+        cout << "          pareto:SHAPE,MIN] [prio=P:WEIGHT,...] [seed=S] [out=FILE] [format=text|bin]\n";
+        cout << "If no args provided, sample dataset will run both algorithms.\n";
+    }
+
+    if(!args.empty() && args[0] == "stream") return stream(args, input_path, max_live, smp, output);
 
     vector<Process> procs;
-    if(argc >= 2){
-        string mode = argv[1];
-        // read processes from stdin (convenient for piping from file)
+    bool ok = true;
+    if(!args.empty()){
+        string mode = args[0];
+        // read processes from stdin (convenient for piping from file) or --input
         // expected input format (first line n):
         // n
         // pid arrival burst priority
         // ...
-        int n;
-        if(!(cin >> n)){
-            cerr << "Expected input: first line = n (number of processes) followed by lines: pid arrival burst priority\n";
-            return 1;
-        }
-        procs.reserve(n);
-        for(int i=0;i<n;i++){
-            int pid,a,b,p;
-            cin >> pid >> a >> b >> p;
-            procs.emplace_back(pid,a,b,p);
-        }
+        InputBuffer in;
+        if(!in.open(input_path) || !load_processes(in, procs, trace_unit)) return 1;
+
+        // positional argument k into v when given; false (reported) when it is
+        // not an integer that fits v
+        auto int_arg = [&](size_t k, auto& v){
+            if(args.size() <= k) return true;
+            using T = remove_reference_t<decltype(v)>;
+            long long x;
+            if(!parse_int(args[k], x)){
+                cerr << mode << ": expected an integer, got " << args[k] << "\n";
+                return false;
+            }
+            if(x < (long long)numeric_limits<T>::min() || x > (long long)numeric_limits<T>::max()){
+                cerr << mode << ": " << args[k] << " out of range\n";
+                return false;
+            }
+            v = (T)x;
+            return true;
+        };
 
         if(mode == "rr"){
             int quantum = 2;
-            if(argc >= 3) quantum = stoi(argv[2]);
-            round_robin(procs, quantum);
+            if(!int_arg(1, quantum)) return 1;
+            if(quantum < 1){
+                cerr << "rr: quantum must be positive\n";
+                return 1;
+            }
+            ok = round_robin(procs, quantum, smp, output);
         } else if(mode == "pps"){
-            preemptive_priority(procs);
+            ok = preemptive_priority(procs, smp, output);
+        } else if(mode == "sjf" || mode == "srtf"){
+            ok = shortest_remaining(procs, mode == "srtf", smp, output);
+        } else if(mode == "edf"){
+            // default horizon: ten of the longest periods past the last arrival
+            long long horizon = 0;
+            for(auto &p: procs) horizon = max(horizon, p.arrival + 10LL * p.period);
+            if(!int_arg(1, horizon)) return 1;
+            if(horizon < 0 || horizon > INT_MAX){
+                cerr << "edf: horizon out of range\n";
+                return 1;
+            }
+            if(count_jobs(procs, (int)horizon) > MAX_JOBS){
+                cerr << "edf: horizon " << horizon << " releases more than " << MAX_JOBS << " jobs\n";
+                return 1;
+            }
+            ok = earliest_deadline_first(procs, (int)horizon, smp, output);
+        } else if(mode == "mixed"){
+            // scaled from the kernel defaults: 100 ms RR timeslice, 0.95 s of every 1 s
+            // and the cfs defaults for the fair class
+            int rr_timeslice = 100, rt_runtime = 950, rt_period = 1000, sched_latency = 6, min_granularity = 1;
+            if(!int_arg(1, rr_timeslice)) return 1;
+            if(!int_arg(2, rt_runtime)) return 1;
+            if(!int_arg(3, rt_period)) return 1;
+            if(!int_arg(4, sched_latency)) return 1;
+            if(!int_arg(5, min_granularity)) return 1;
+            if(rr_timeslice < 1 || rt_period < 1 || rt_runtime == 0 || rt_runtime < -1 || rt_runtime > rt_period){
+                cerr << "mixed: need rr_timeslice >= 1 and 1 <= rt_runtime <= rt_period (or rt_runtime -1)\n";
+                return 1;
+            }
+            if(sched_latency < 1 || min_granularity < 1){
+                cerr << "mixed: sched_latency and min_granularity must be positive\n";
+                return 1;
+            }
+            for(auto &p: procs){
+                bool rt = p.policy == ClassScheduler::FIFO || p.policy == ClassScheduler::RR;
+                if(p.policy != ClassScheduler::OTHER && !rt){
+                    cerr << "mixed: P" << p.pid << " has policy " << p.policy << ", expected 0 (OTHER), 1 (FIFO) or 2 (RR)\n";
+                    return 1;
+                }
+                if(rt && (p.priority < 1 || p.priority > 99)){
+                    cerr << "mixed: RT priority of P" << p.pid << " outside 1..99\n";
+                    return 1;
+                }
+            }
+            ok = mixed(procs, rr_timeslice, rt_runtime, rt_period, sched_latency, min_granularity, smp, output);
+        } else if(mode == "lottery" || mode == "stride"){
+            int quantum = 1;
+            if(!int_arg(1, quantum)) return 1;
+            if(quantum < 1){
+                cerr << mode << ": quantum must be positive\n";
+                return 1;
+            }
+            if(mode == "stride"){
+                ok = stride(procs, quantum, smp, output);
+            } else {
+                uint32_t seed = 1;
+                if(!int_arg(2, seed)) return 1;
+                ok = lottery(procs, quantum, seed, smp, output);
+            }
+        } else if(mode == "sweep"){
+            int qmin = 1, qmax = 10, qstep = 1;
+            if(!int_arg(1, qmin)) return 1;
+            if(!int_arg(2, qmax)) return 1;
+            if(!int_arg(3, qstep)) return 1;
+            if(qmin < 1 || qmax < qmin || qstep < 1){
+                cerr << "sweep: need 1 <= qmin <= qmax and qstep >= 1\n";
+                return 1;
+            }
+            sweep(procs, qmin, qmax, qstep, threads, smp);
+        } else if(mode == "pps-o1"){
+            for(auto &p: procs){
+                if(p.priority < 0 || p.priority >= PriorityArray::MAX_PRIO){
+                    cerr << mode << ": priority of P" << p.pid << " outside 0.." << PriorityArray::MAX_PRIO - 1 << "\n";
+                    return 1;
+                }
+            }
+            ok = preemptive_priority_o1(procs, smp, output);
+        } else if(mode == "cfs"){
+            int sched_latency = 6, min_granularity = 1;
+            if(!int_arg(1, sched_latency)) return 1;
+            if(!int_arg(2, min_granularity)) return 1;
+            if(sched_latency < 1 || min_granularity < 1){
+                cerr << "cfs: sched_latency and min_granularity must be positive\n";
+                return 1;
+            }
+            ok = completely_fair(procs, sched_latency, min_granularity, smp, output);
+        } else if(mode == "mlfq"){
+            // mlfq [levels] [quantum] [boost]: quantum is one base (doubled per
+            // level) or a comma-separated list with one quantum per level
+            int levels = 3, boost_interval = 50;
+            if(!int_arg(1, levels)) return 1;
+            if(levels < 1 || levels > Mlfq::MAX_LEVELS){
+                cerr << "mlfq: levels must be 1.." << Mlfq::MAX_LEVELS << "\n";
+                return 1;
+            }
+            vector<int> quantum;
+            string qarg = args.size() >= 3 ? args[2] : "2";
+            if(qarg.find(',') == string::npos){
+                int q = 2;
+                if(!int_arg(2, q)) return 1;
+                if(q < 1){
+                    cerr << "mlfq: need one positive quantum per level\n";
+                    return 1;
+                }
+                for(int l=0;l<levels;l++) quantum.push_back((int)min<long long>((long long)q << min(l, 30), INT_MAX));
+            } else {
+                stringstream ss(qarg);
+                for(string tok; getline(ss, tok, ',');){
+                    long long q;
+                    if(!parse_int(tok, q) || q < INT_MIN || q > INT_MAX){
+                        cerr << "mlfq: expected an integer, got " << tok << "\n";
+                        return 1;
+                    }
+                    quantum.push_back((int)q);
+                }
+            }
+            if((int)quantum.size() != levels || *min_element(quantum.begin(), quantum.end()) < 1){
+                cerr << "mlfq: need one positive quantum per level\n";
+                return 1;
+            }
+            if(!int_arg(3, boost_interval)) return 1;
+            if(boost_interval < 0){
+                cerr << "mlfq: boost interval must be >= 0 (0 = no boost)\n";
+                return 1;
+            }
+            ok = multi_level_feedback(procs, quantum, boost_interval, smp, output);
+        } else if(mode == "eevdf"){
+            int max_slice = INT_MAX;
+            if(!int_arg(1, max_slice)) return 1;
+            if(max_slice < 1){
+                cerr << "eevdf: max_slice must be positive\n";
+                return 1;
+            }
+            ok = earliest_eligible_deadline(procs, max_slice, smp, output);
         } else {
             cerr << "Unknown mode: " << mode << "\n";
             return 1;
@@ -279,10 +306,10 @@ int main(int argc, char** argv){
     } else {
         // run sample
         procs = load_sample();
-        round_robin(procs, 2);
+        round_robin(procs, 2, smp);
         for(auto &p: procs){ p.remaining = p.burst; p.start_time=-1; p.completion_time=0; p.waiting_time=0; p.turnaround_time=0;}
-        preemptive_priority(procs);
+        preemptive_priority(procs, smp);
     }
 
-    return 0;
+    return ok ? 0 : 1;
 }
@@ -0,0 +1,257 @@
+// src/gen.cpp - synthetic workload generator
+
+#include "schedsim/gen.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "schedsim/io.hpp"
+
+namespace schedsim {
+using namespace std;
+
+bool parse_distribution(const string& spec, const map<string,int>& kinds, Distribution& d){
+    size_t colon = spec.find(':');
+    d.kind = spec.substr(0, colon);
+    d.a.clear();
+    auto k = kinds.find(d.kind);
+    if(k == kinds.end() || colon == string::npos) return false;
+    stringstream ss(spec.substr(colon + 1));
+    for(string tok; getline(ss, tok, ',');){
+        char* e;
+        double v = strtod(tok.c_str(), &e);
+        if(tok.empty() || *e || !(fabs(v) <= 1e12)) return false;
+        d.a.push_back(v);
+    }
+    return (int)d.a.size() == k->second;
+}
+
+const int GEN_CHUNK = 1 << 16;
+
+// Processes [first, first + count) from generators seeded by (seed, chunk):
+// one stream for arrivals, one for bursts and priorities, so the arrival
+// times can be drawn on their own to find where each chunk starts.
+struct GenChunk {
+    const GenConfig& g;
+    mt19937_64 arr, attr;
+    int state = 0; // MMPP state
+
+    static uint64_t mix(uint64_t x){ // splitmix64 finalizer
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    GenChunk(const GenConfig& g, long long chunk)
+        :g(g), arr(mix(g.seed ^ mix(2 * chunk))), attr(mix(g.seed ^ mix(2 * chunk + 1))){
+        // start the MMPP in its stationary distribution
+        if(g.arrival.kind == "mmpp"){
+            double s01 = g.arrival.a[2], s10 = g.arrival.a[3];
+            state = uniform(arr) * (s01 + s10) < s01 ? 1 : 0;
+        }
+    }
+
+    // in [0, 1), from the top 53 bits
+    static double uniform(mt19937_64& r){ return (r() >> 11) * 0x1.0p-53; }
+    static double exponential(mt19937_64& r, double rate){ return -log1p(-uniform(r)) / rate; }
+
+    double next_gap(){
+        if(g.arrival.kind == "poisson") return exponential(arr, g.arrival.a[0]);
+        // competing exponentials: the next arrival or the next state switch
+        double gap = 0;
+        while(true){
+            double rate = g.arrival.a[state], sw = g.arrival.a[2 + state];
+            gap += exponential(arr, rate + sw);
+            if(uniform(arr) * (rate + sw) < rate) return gap;
+            state ^= 1;
+        }
+    }
+
+    int next_burst(){
+        const Distribution &b = g.burst;
+        double x;
+        if(b.kind == "exp"){
+            x = exponential(attr, 1 / b.a[0]);
+        } else if(b.kind == "lognormal"){
+            double u = 1 - uniform(attr), v = uniform(attr);
+            x = exp(b.a[0] + b.a[1] * sqrt(-2 * log(u)) * cos(2 * M_PI * v));
+        } else { // pareto: shape, minimum
+            x = b.a[1] / pow(1 - uniform(attr), 1 / b.a[0]);
+        }
+        return (int)min(max(1.0, ceil(x)), 1e9);
+    }
+
+    int next_priority(double total){
+        double u = uniform(attr) * total;
+        for(auto &p: g.prio){
+            if(u < p.second) return p.first;
+            u -= p.second;
+        }
+        return g.prio.back().first;
+    }
+};
+
+int generate(const GenConfig& g, int threads){
+    long long chunks = (g.n + GEN_CHUNK - 1) / GEN_CHUNK;
+    auto chunk_size = [&](long long c){ return (int)min<long long>(GEN_CHUNK, g.n - c * GEN_CHUNK); };
+    auto parallel = [&](long long begin, long long end, const function<void(long long)>& f){
+        atomic<long long> next(begin);
+        auto worker = [&](){ for(long long c; (c = next++) < end; ) f(c); };
+        vector<thread> pool;
+        for(int t=1;t<min<long long>(threads, end - begin);t++) pool.emplace_back(worker);
+        worker();
+        for(auto &t: pool) t.join();
+    };
+
+    double total_weight = 0;
+    for(auto &p: g.prio) total_weight += p.second;
+
+    vector<double> start(chunks + 1, 0);
+    vector<long long> work(chunks, 0);
+    parallel(0, chunks, [&](long long c){
+        GenChunk gen(g, c);
+        double t = 0;
+        long long w = 0;
+        for(int i=0;i<chunk_size(c);i++){
+            t += gen.next_gap();
+            w += gen.next_burst();
+            gen.next_priority(total_weight);
+        }
+        start[c + 1] = t;
+        work[c] = w;
+    });
+    long long total_work = 0;
+    for(long long c=0;c<chunks;c++){
+        start[c + 1] += start[c];
+        total_work += work[c];
+    }
+    if(start[chunks] > INT_MAX){
+        cerr << "gen: arrivals run past " << INT_MAX << "; raise the arrival rate\n";
+        return 1;
+    }
+    // the bound SpanCheck puts on loading the result
+    if(start[chunks] + total_work > INT_MAX){
+        cerr << "gen: arrivals plus total burst time run past " << INT_MAX << "; lower N or the burst sizes\n";
+        return 1;
+    }
+
+    bool use_stdout = g.out == "-";
+    FILE* f = use_stdout ? stdout : fopen(g.out.c_str(), "wb");
+    if(!f){
+        cerr << "cannot write " << g.out << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+    bool ok = true;
+    if(g.binary){
+        TraceHeader h = make_trace_header(TRACE_PROCESSES, g.n, sizeof(ProcessRecord));
+        ok = fwrite(&h, sizeof h, 1, f) == 1;
+    } else {
+        ok = fprintf(f, "%lld\n", g.n) > 0;
+    }
+    long long window = 2LL * threads;
+    vector<string> out(window);
+    for(long long w=0; w<chunks && ok; w+=window){
+        long long end = min(chunks, w + window);
+        parallel(w, end, [&](long long c){
+            GenChunk gen(g, c);
+            string &buf = out[c - w];
+            buf.clear();
+            double t = start[c];
+            char line[64];
+            for(int i=0;i<chunk_size(c);i++){
+                t += gen.next_gap();
+                ProcessRecord r{(int32_t)(c * GEN_CHUNK + i + 1), (int32_t)t, gen.next_burst(),
+                                gen.next_priority(total_weight)};
+                if(g.binary){
+                    buf.append((const char*)&r, sizeof r);
+                    continue;
+                }
+                char* e = line;
+                for(int32_t v: {r.pid, r.arrival, r.burst, r.priority}){
+                    if(e != line) *e++ = ' ';
+                    e = to_chars(e, line + sizeof line, v).ptr;
+                }
+                *e++ = '\n';
+                buf.append(line, e - line);
+            }
+        });
+        for(long long c=w;c<end && ok;c++) ok = fwrite(out[c - w].data(), 1, out[c - w].size(), f) == out[c - w].size();
+    }
+    ok = (use_stdout ? fflush(f) == 0 : fclose(f) == 0) && ok;
+    if(!ok){
+        cerr << "write error on " << g.out << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int gen(const vector<string>& args, int threads){
+    GenConfig g;
+    if(args.size() < 2 || !parse_int(args[1], g.n) || g.n < 0 || g.n > INT_MAX){
+        cerr << "usage: gen N [arrival=poisson:RATE|mmpp:RATE0,RATE1,SWITCH01,SWITCH10]\n"
+             << "             [burst=exp:MEAN|lognormal:MU,SIGMA|pareto:SHAPE,MIN]\n"
+             << "             [prio=P:WEIGHT,...] [seed=S] [out=FILE] [format=text|bin]\n";
+        return 1;
+    }
+    for(size_t i=2;i<args.size();i++){
+        size_t eq = args[i].find('=');
+        string key = args[i].substr(0, eq), value = eq == string::npos ? "" : args[i].substr(eq + 1);
+        bool ok = true;
+        if(key == "arrival"){
+            ok = parse_distribution(value, {{"poisson", 1}, {"mmpp", 4}}, g.arrival)
+                 && g.arrival.a[0] > 0 && (g.arrival.kind == "poisson" || (g.arrival.a[1] > 0
+                 && g.arrival.a[2] >= 0 && g.arrival.a[3] >= 0 && g.arrival.a[2] + g.arrival.a[3] > 0));
+        } else if(key == "burst"){
+            ok = parse_distribution(value, {{"exp", 1}, {"lognormal", 2}, {"pareto", 2}}, g.burst)
+                 && (g.burst.kind == "lognormal" ? g.burst.a[1] >= 0  // MU may be negative
+                     : g.burst.a[0] > 0 && (g.burst.kind == "exp" || g.burst.a[1] > 0));
+        } else if(key == "prio"){
+            g.prio.clear();
+            stringstream ss(value);
+            for(string tok; getline(ss, tok, ',');){
+                int p; double w; char c;
+                stringstream ts(tok);
+                if(!(ts >> p >> c >> w) || c != ':' || !(w > 0) || !ts.eof()){ ok = false; break; }
+                g.prio.push_back({p, w});
+            }
+            ok = ok && !g.prio.empty();
+        } else if(key == "seed"){
+            auto r = from_chars(value.data(), value.data() + value.size(), g.seed);
+            ok = !value.empty() && r.ec == errc() && r.ptr == value.data() + value.size();
+        } else if(key == "out"){
+            ok = !value.empty();
+            g.out = value;
+        } else if(key == "format"){
+            ok = value == "text" || value == "bin";
+            g.binary = value == "bin";
+        } else {
+            ok = false;
+        }
+        if(!ok){
+            cerr << "gen: bad argument " << args[i] << "\n";
+            return 1;
+        }
+    }
+    return generate(g, threads);
+}
+
+} // namespace schedsim
@@ -0,0 +1,689 @@
+// src/io.cpp - process lists, binary traces and kernel sched dumps
+
+#include "schedsim/io.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace schedsim {
+using namespace std;
+
+InputBuffer::~InputBuffer(){ if(map) munmap(map, size); }
+
+bool InputBuffer::open(const string& path){
+    bool use_stdin = path.empty() || path == "-";
+    int fd = use_stdin ? 0 : ::open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        cerr << "cannot open " << path << ": " << strerror(errno) << "\n";
+        return false;
+    }
+    struct stat st;
+    if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0){
+        void* m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(m != MAP_FAILED){
+            madvise(m, st.st_size, MADV_SEQUENTIAL);
+            map = m; data = (const char*)m; size = st.st_size;
+            if(!use_stdin) close(fd);
+            return true;
+        }
+    }
+    size_t len = 0;
+    buf.resize(1 << 20);
+    while(true){
+        if(len == buf.size()) buf.resize(buf.size() * 2);
+        ssize_t r = read(fd, buf.data() + len, buf.size() - len);
+        if(r == 0) break;
+        if(r < 0){
+            if(errno == EINTR) continue;
+            cerr << "read error: " << strerror(errno) << "\n";
+            if(!use_stdin) close(fd);
+            return false;
+        }
+        len += r;
+    }
+    if(!use_stdin) close(fd);
+    data = buf.data(); size = len;
+    return true;
+}
+
+int scan_ints(const char* p, const char* end, long long* out, int max, int& bad_col,
+              vector<long long>* list){
+    const char* line = p;
+    int k = 0;
+    if(list) list->clear();
+    while(true){
+        while(p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if(p == end) return k;
+        long long v;
+        auto r = from_chars(p, end, v);
+        while(list && k == 2 && r.ec == errc() && r.ptr < end && *r.ptr == ','){
+            list->push_back(v);
+            r = from_chars(r.ptr + 1, end, v);
+        }
+        if(list && k == 2 && !list->empty()) list->push_back(v);
+        bool delimited = r.ptr == end || *r.ptr == ' ' || *r.ptr == '\t' || *r.ptr == '\r';
+        if(r.ec != errc() || !delimited || k == max){
+            bad_col = (int)(p - line) + 1;
+            return -1;
+        }
+        out[k++] = v;
+        p = r.ptr;
+    }
+}
+
+bool parse_int(const string& s, long long& v){
+    const char* end = s.data() + s.size();
+    auto r = from_chars(s.data(), end, v);
+    return !s.empty() && r.ec == errc() && r.ptr == end;
+}
+
+bool parse_processes(const char* data, size_t size, vector<Process>& procs){
+    const int MAX_REPORTED = 10;
+    const char *p = data, *end = data + size;
+    long long line_no = 0, expected = -1, errors = 0;
+    auto report = [&](const string& msg){
+        if(errors++ < MAX_REPORTED) cerr << "line " << line_no << ": " << msg << "\n";
+    };
+    procs.clear();
+    vector<long long> bursts;
+    SpanCheck span;
+    while(p < end){
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        if(!eol) eol = end;
+        line_no++;
+        long long v[7] = {};
+        int bad_col = 0;
+        int k = scan_ints(p, eol, v, 7, bad_col, &bursts);
+        p = eol + (eol < end);
+        if(k == 0) continue;
+        if(expected < 0){
+            if(k != 1 || v[0] < 0 || v[0] > INT_MAX){
+                report("expected the process count n on the first line");
+                break;
+            }
+            expected = v[0];
+            // cap the up-front reservation by what the buffer could hold
+            procs.reserve(min<long long>(expected, size / 8 + 1));
+            continue;
+        }
+        if(k < 0){ report("bad token at column " + to_string(bad_col)); continue; }
+        if(k < 4){
+            report("expected 4 to 7 integers (pid arrival burst priority [policy] [deadline period]), got "
+                   + to_string(k));
+            continue;
+        }
+        long long policy = 0, deadline = 0, period = 0, io = 0;
+        if(k == 5 || k == 7) policy = v[4];
+        if(k >= 6){ deadline = v[k-2]; period = v[k-1]; }
+        if(!bursts.empty()){
+            if(bursts.size() % 2 == 0){ report("a burst list alternates cpu,io,... and ends with CPU"); continue; }
+            bool positive = true;
+            v[2] = 0;
+            for(size_t j=0;j<bursts.size();j++){
+                positive = positive && bursts[j] > 0;
+                (j % 2 ? io : v[2]) += bursts[j];
+            }
+            if(!positive){ report("burst list entries must be positive"); continue; }
+            if(v[2] + io > INT_MAX){ report("value out of range"); continue; }
+        }
+        bool fits = true;
+        for(long long x: v) fits = fits && x >= INT_MIN && x <= INT_MAX;
+        if(!fits){ report("value out of range"); continue; }
+        if(v[1] < 0){ report("negative arrival time"); continue; }
+        if(v[2] < 0){ report("negative burst"); continue; }
+        if(policy < 0){ report("negative policy"); continue; }
+        if(deadline < 0 || period < 0){ report("negative deadline or period"); continue; }
+        if((long long)procs.size() == expected){ report("more processes than n = " + to_string(expected)); break; }
+        if(!span.add(v[1], v[2], io)){ report(SPAN_ERROR); break; }
+        procs.emplace_back((int)v[0], (int)v[1], (int)v[2], (int)v[3]);
+        procs.back().policy = (int)policy;
+        procs.back().io_time = (int)io;
+        procs.back().bursts.assign(bursts.begin(), bursts.end());
+        procs.back().deadline = (int)deadline;
+        procs.back().period = (int)period;
+    }
+    if(expected < 0 && errors == 0){
+        cerr << "Expected input: first line = n (number of processes) followed by lines: pid arrival burst priority\n";
+        return false;
+    }
+    if(errors == 0 && (long long)procs.size() != expected){
+        cerr << "expected " << expected << " processes, found " << procs.size() << "\n";
+        return false;
+    }
+    if(errors > MAX_REPORTED) cerr << "... " << errors - MAX_REPORTED << " more malformed lines\n";
+    return errors == 0;
+}
+
+TraceHeader make_trace_header(TraceKind kind, uint64_t count, uint32_t record_size){
+    TraceHeader h;
+    memset(&h, 0, sizeof h);
+    memcpy(h.magic, TRACE_MAGIC, sizeof h.magic);
+    h.version = TRACE_VERSION;
+    h.kind = kind;
+    h.count = count;
+    h.record_size = record_size;
+    return h;
+}
+
+bool is_binary_trace(const char* data, size_t size){
+    return size >= sizeof(TraceHeader) && memcmp(data, TRACE_MAGIC, sizeof TRACE_MAGIC) == 0;
+}
+
+bool check_trace_header(const TraceHeader& h, TraceKind kind, uint32_t record_size){
+    if(h.version != TRACE_VERSION){
+        cerr << "unsupported trace version " << h.version << "\n";
+        return false;
+    }
+    if(h.kind != kind || h.record_size != record_size){
+        cerr << "trace holds kind " << h.kind << " records of " << h.record_size << " bytes, expected kind "
+             << kind << " of " << record_size << "\n";
+        return false;
+    }
+    return true;
+}
+
+const TraceHeader* trace_header(const char* data, size_t size, TraceKind kind, uint32_t record_size){
+    if(!is_binary_trace(data, size)){
+        cerr << "not a binary trace\n";
+        return nullptr;
+    }
+    const TraceHeader* h = (const TraceHeader*)data;
+    if(!check_trace_header(*h, kind, record_size)) return nullptr;
+    if(h->count > (size - sizeof(TraceHeader)) / record_size){
+        cerr << "truncated trace: header promises " << h->count << " records\n";
+        return nullptr;
+    }
+    return h;
+}
+
+bool load_processes_binary(const char* data, size_t size, vector<Process>& procs){
+    const TraceHeader* h = trace_header(data, size, TRACE_PROCESSES, sizeof(ProcessRecord));
+    if(!h) return false;
+    const ProcessRecord* r = (const ProcessRecord*)(data + sizeof(TraceHeader));
+    procs.clear();
+    procs.reserve(h->count);
+    SpanCheck span;
+    for(uint64_t i=0;i<h->count;i++){
+        if(r[i].arrival < 0 || r[i].burst < 0){
+            cerr << "record " << i << ": negative arrival or burst\n";
+            return false;
+        }
+        if(!span.add(r[i].arrival, r[i].burst, 0)){
+            cerr << "record " << i << ": " << SPAN_ERROR << "\n";
+            return false;
+        }
+        procs.emplace_back(r[i].pid, r[i].arrival, r[i].burst, r[i].priority);
+    }
+    return true;
+}
+
+// Scheduler event dumps as a workload: ftrace / trace-cmd report text and
+// perf script output of sched_switch, sched_wakeup(_new) and
+// sched_process_exit, with fields as key=value or in perf's compact form
+// ("comm:pid [prio] state ==> comm:pid [prio]"). One pass over the dump
+// rebuilds each task's life: it arrives when first woken or seen, runs
+// between switch-in and switch-out (a switch-out in state R is a preemption
+// and continues the CPU burst), and sleeps from a switch-out in any other
+// state until its next wakeup, which becomes an I/O burst. A task ends on
+// exit, state X or Z, or at the end of the dump (dropping a trailing sleep,
+// or a trailing wakeup it never ran after). Times count from the first event
+// in units of unit_us microseconds, rounded to nearest; each burst is at
+// least 1. Kernel prio 100..139 becomes nice
+// (priority - 120); RT prio 0..98 becomes SCHED_FIFO (policy 1) with
+// rt_priority 99 - prio. Tasks that never ran, and pid 0, are left out.
+struct SchedTraceImporter {
+    struct Task {
+        int pid = 0, prio = 120;
+        long long arrival = 0;
+        long long run_start = -1;   // on a CPU since
+        long long sleep_start = -1; // blocked since
+        long long cpu = 0;          // current CPU burst so far
+        bool ran = false;
+        vector<long long> bursts;   // closed bursts: CPU, I/O, CPU, ...
+    };
+    long long unit_us;
+    long long t0 = -1, now = 0;
+    unordered_map<int, Task> live;
+    vector<Process>& procs;
+    long long bad_lines = 0;
+
+    SchedTraceImporter(vector<Process>& procs, long long unit_us):unit_us(unit_us), procs(procs){}
+
+    Task& task(int pid){
+        auto it = live.find(pid);
+        if(it != live.end()) return it->second;
+        Task &t = live[pid];
+        t.pid = pid;
+        t.arrival = now;
+        return t;
+    }
+
+    long long round_units(long long us) const { return (us + unit_us / 2) / unit_us; }
+    long long units(long long us) const { return max(1LL, round_units(us)); }
+
+    void finish(Task& t){
+        if(t.run_start >= 0) t.cpu += now - t.run_start;
+        if(t.bursts.size() % 2 == 0 && t.cpu == 0 && !t.bursts.empty()){
+            t.bursts.pop_back(); // woken but never ran again: drop the wait
+        } else if(t.bursts.size() % 2 == 0 || t.cpu > 0){
+            t.bursts.push_back(t.cpu);
+        }
+        if(t.ran){
+            Process p(t.pid, (int)min<long long>(round_units(t.arrival), INT_MAX), 0, t.prio - 120);
+            if(t.prio < 100){ p.priority = 99 - t.prio; p.policy = 1; }
+            long long cpu = 0, io = 0;
+            for(size_t j=0;j<t.bursts.size();j++) (j % 2 ? io : cpu) += units(t.bursts[j]);
+            p.burst = p.remaining = (int)min<long long>(cpu, INT_MAX);
+            p.io_time = (int)min<long long>(io, INT_MAX);
+            if(t.bursts.size() > 1)
+                for(long long b: t.bursts) p.bursts.push_back((int)min<long long>(units(b), INT_MAX));
+            procs.push_back(move(p));
+        }
+        live.erase(t.pid);
+    }
+
+    void wakeup(int pid, int prio){
+        if(pid == 0) return;
+        Task &t = task(pid);
+        t.prio = prio;
+        if(t.sleep_start >= 0){
+            t.bursts.push_back(now - t.sleep_start);
+            t.sleep_start = -1;
+        }
+    }
+
+    void switch_out(int pid, const string& state){
+        if(pid == 0) return;
+        Task &t = task(pid);
+        if(t.run_start >= 0){ t.cpu += now - t.run_start; t.run_start = -1; }
+        if(state[0] == 'X' || state[0] == 'Z') return finish(t);
+        if(state[0] == 'R') return; // preempted, still runnable
+        t.bursts.push_back(t.cpu);
+        t.cpu = 0;
+        t.sleep_start = now;
+    }
+
+    void switch_in(int pid, int prio){
+        if(pid == 0) return;
+        Task &t = task(pid);
+        if(t.sleep_start >= 0) wakeup(pid, prio); // the wakeup was not traced
+        t.prio = prio;
+        t.run_start = now;
+        t.ran = true;
+    }
+
+    // value of " key=" in [b, e)
+    static bool field(const char* b, const char* e, const char* key, string& v){
+        size_t n = strlen(key);
+        for(const char* p = b; (p = (const char*)memmem(p, e - p, key, n)); p++){
+            if(p != b && p[-1] != ' ') continue;
+            const char* q = p + n;
+            const char* end = q;
+            while(end < e && *end != ' ') end++;
+            v.assign(q, end);
+            return true;
+        }
+        return false;
+    }
+
+    // perf's compact "comm:pid [prio]" ending at or before e; comm may hold spaces
+    static bool compact_task(const char* b, const char* e, int& pid, int& prio){
+        const char* open = (const char*)memchr(b, '[', e - b);
+        if(!open) return false;
+        const char* colon = open;
+        while(colon > b && *colon != ':') colon--;
+        if(*colon != ':') return false;
+        return sscanf(colon + 1, "%d [%d]", &pid, &prio) == 2;
+    }
+
+    // one line; anything that is not a known sched event is skipped
+    void line(const char* b, const char* e){
+        static const char* events[] = {"sched_switch: ", "sched_wakeup: ", "sched_wakeup_new: ", "sched_process_exit: "};
+        int kind = -1;
+        const char* ev = nullptr;
+        for(int k=0;k<4 && kind<0;k++){
+            const char* p = (const char*)memmem(b, e - b, events[k], strlen(events[k]));
+            if(p){ kind = k; ev = p; }
+        }
+        if(kind < 0) return;
+        const char* args = ev + strlen(events[kind]);
+        // timestamp "secs.frac:" before the event name (perf adds "sched:")
+        const char* p = ev;
+        if(p - b >= 6 && !memcmp(p - 6, "sched:", 6)) p -= 6;
+        while(p > b && p[-1] == ' ') p--;
+        if(p == b || p[-1] != ':'){ bad_lines++; return; }
+        const char* ts_end = --p;
+        while(p > b && (isdigit((unsigned char)p[-1]) || p[-1] == '.')) p--;
+        const char* dot = (const char*)memchr(p, '.', ts_end - p);
+        if(p == ts_end || !dot){ bad_lines++; return; }
+        long long us = 0;
+        for(const char* q = p; q < dot; q++) us = us * 10 + (*q - '0');
+        int digits = 0;
+        for(const char* q = dot + 1; q < ts_end && digits < 6; q++, digits++) us = us * 10 + (*q - '0');
+        for(; digits < 6; digits++) us *= 10;
+        if(t0 < 0) t0 = us;
+        now = max(now, us - t0);
+
+        string v, w;
+        if(kind == 0){
+            int prev = 0, prev_prio = 120, next = 0, next_prio = 120;
+            string state;
+            if(field(args, e, "prev_pid=", v) && field(args, e, "next_pid=", w) && field(args, e, "prev_state=", state)){
+                prev = atoi(v.c_str()); next = atoi(w.c_str());
+                if(field(args, e, "prev_prio=", v)) prev_prio = atoi(v.c_str());
+                if(field(args, e, "next_prio=", v)) next_prio = atoi(v.c_str());
+            } else {
+                const char* arrow = (const char*)memmem(args, e - args, "==>", 3);
+                if(!arrow || !compact_task(args, arrow, prev, prev_prio) || !compact_task(arrow, e, next, next_prio)){
+                    bad_lines++;
+                    return;
+                }
+                const char* s = arrow;
+                while(s > args && s[-1] == ' ') s--;
+                const char* s0 = s;
+                while(s0 > args && s0[-1] != ' ' && s0[-1] != ']') s0--;
+                state.assign(s0, s);
+            }
+            if(state.empty()){ bad_lines++; return; }
+            (void)prev_prio;
+            switch_out(prev, state);
+            switch_in(next, next_prio);
+            return;
+        }
+        int pid = 0, prio = 120;
+        if(field(args, e, "pid=", v)){
+            pid = atoi(v.c_str());
+            if(field(args, e, "prio=", v)) prio = atoi(v.c_str());
+        } else if(!compact_task(args, e, pid, prio)){
+            bad_lines++;
+            return;
+        }
+        if(kind == 3){
+            auto it = live.find(pid);
+            if(it != live.end()) finish(it->second);
+        } else {
+            wakeup(pid, prio);
+        }
+    }
+
+    void run(const char* data, size_t size){
+        for(const char *p = data, *end = data + size; p < end;){
+            const char* eol = (const char*)memchr(p, '\n', end - p);
+            if(!eol) eol = end;
+            line(p, eol);
+            p = eol + 1;
+        }
+        while(!live.empty()) finish(live.begin()->second);
+        sort(procs.begin(), procs.end(), [](const Process& a, const Process& b){
+            return a.arrival != b.arrival ? a.arrival < b.arrival : a.pid < b.pid;
+        });
+    }
+};
+
+bool is_sched_trace(const char* data, size_t size){
+    size_t head = min<size_t>(size, 1 << 20);
+    if(!memmem(data, head, "sched_switch", 12)) return false;
+    long long v;
+    int bad_col;
+    const char* eol = (const char*)memchr(data, '\n', head);
+    return scan_ints(data, eol ? eol : data + head, &v, 1, bad_col) != 1;
+}
+
+bool load_sched_trace(const char* data, size_t size, vector<Process>& procs, long long unit_us){
+    procs.clear();
+    SchedTraceImporter imp(procs, unit_us);
+    imp.run(data, size);
+    if(imp.bad_lines) cerr << "warning: " << imp.bad_lines << " sched event lines not understood\n";
+    if(imp.now / unit_us > INT_MAX){
+        cerr << "trace spans more than " << INT_MAX << " units of " << unit_us << " us; use a larger --trace-unit\n";
+        return false;
+    }
+    SpanCheck span;
+    for(auto &p: procs){
+        if(!span.add(p.arrival, p.burst, p.io_time)){
+            cerr << "P" << p.pid << ": " << SPAN_ERROR << "; use a larger --trace-unit\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool load_processes(const InputBuffer& in, vector<Process>& procs, long long trace_unit_us){
+    if(is_binary_trace(in.data, in.size)) return load_processes_binary(in.data, in.size, procs);
+    if(is_sched_trace(in.data, in.size)) return load_sched_trace(in.data, in.size, procs, trace_unit_us);
+    return parse_processes(in.data, in.size, procs);
+}
+
+ProcessReader::~ProcessReader(){ if(own_fd) close(fd); }
+
+bool ProcessReader::open(const string& path){
+    own_fd = !(path.empty() || path == "-");
+    fd = own_fd ? ::open(path.c_str(), O_RDONLY) : 0;
+    if(fd < 0){
+        own_fd = false;
+        cerr << "cannot open " << path << ": " << strerror(errno) << "\n";
+        return false;
+    }
+    fill(sizeof(TraceHeader));
+    if(failed) return false;
+    binary = is_binary_trace(buf.get() + begin, end - begin);
+    if(binary){
+        TraceHeader h;
+        memcpy(&h, buf.get() + begin, sizeof h);
+        if(!check_trace_header(h, TRACE_PROCESSES, sizeof(ProcessRecord))) return false;
+        records_left = h.count;
+        begin += sizeof h;
+    }
+    return true;
+}
+
+void ProcessReader::fill(size_t want){
+    if(begin > 0){
+        memmove(buf.get(), buf.get() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    while(end < want && !eof){
+        ssize_t r = read(fd, buf.get() + end, CAP - end);
+        if(r == 0) eof = true;
+        else if(r > 0) end += r;
+        else if(errno != EINTR){
+            cerr << "read error: " << strerror(errno) << "\n";
+            failed = eof = true;
+        }
+    }
+}
+
+bool ProcessReader::error(const string& msg){
+    cerr << (binary ? "record " : "line ") << line_no << ": " << msg << "\n";
+    failed = true;
+    return false;
+}
+
+bool ProcessReader::next(Process& p){
+    if(failed) return false;
+    long long v[4];
+    if(binary){
+        if(records_left == 0) return false;
+        if(end - begin < sizeof(ProcessRecord)) fill(sizeof(ProcessRecord));
+        line_no++;
+        if(end - begin < sizeof(ProcessRecord)) return error("truncated trace");
+        ProcessRecord r;
+        memcpy(&r, buf.get() + begin, sizeof r);
+        begin += sizeof r;
+        records_left--;
+        v[0] = r.pid; v[1] = r.arrival; v[2] = r.burst; v[3] = r.priority;
+    } else {
+        while(true){
+            const char* nl = (const char*)memchr(buf.get() + begin, '\n', end - begin);
+            if(!nl && !eof){
+                if(end - begin == CAP){ line_no++; return error("line too long"); }
+                fill(end - begin + 1);
+                continue;
+            }
+            if(!nl && begin == end) return false;
+            const char* line = buf.get() + begin;
+            const char* eol = nl ? nl : buf.get() + end;
+            begin = eol - buf.get() + (nl != nullptr);
+            line_no++;
+            int bad_col = 0;
+            int k = scan_ints(line, eol, v, 4, bad_col);
+            if(k == 0) continue;
+            bool first = !started;
+            started = true;
+            if(k == 1 && first) continue; // count line
+            if(k < 0) return error("bad token at column " + to_string(bad_col));
+            if(k != 4) return error("expected 4 integers (pid arrival burst priority), got " + to_string(k));
+            break;
+        }
+        for(long long x: v) if(x < INT_MIN || x > INT_MAX) return error("value out of range");
+    }
+    if(v[1] < 0) return error("negative arrival time");
+    if(v[2] < 0) return error("negative burst");
+    if(any && v[1] < last_arrival)
+        return error("arrival " + to_string(v[1]) + " is earlier than the previous " + to_string(last_arrival));
+    any = true;
+    last_arrival = v[1];
+    // arrivals come in order, so idle gaps do not count against the clock
+    busy_until = max(busy_until, v[1]) + v[2];
+    if(busy_until > INT_MAX) return error(SPAN_ERROR);
+    p = Process((int)v[0], (int)v[1], (int)v[2], (int)v[3]);
+    return true;
+}
+
+bool write_trace(const string& path, const TraceHeader& h, const void* records, size_t bytes){
+    bool use_stdout = path == "-";
+    FILE* f = use_stdout ? stdout : fopen(path.c_str(), "wb");
+    if(!f){
+        cerr << "cannot write " << path << ": " << strerror(errno) << "\n";
+        return false;
+    }
+    bool ok = fwrite(&h, sizeof h, 1, f) == 1 && (bytes == 0 || fwrite(records, bytes, 1, f) == 1);
+    ok = (use_stdout ? fflush(f) == 0 : fclose(f) == 0) && ok;
+    if(!ok) cerr << "write error on " << path << "\n";
+    return ok;
+}
+
+bool write_processes_binary(const string& path, const vector<Process>& procs){
+    for(auto &p: procs){
+        if(p.deadline || p.period || p.policy || !p.bursts.empty()){
+            cerr << "P" << p.pid << ": version " << TRACE_VERSION
+                 << " binary traces have no policy, deadline, period or burst list\n";
+            return false;
+        }
+    }
+    vector<ProcessRecord> recs(procs.size());
+    for(size_t i=0;i<procs.size();i++)
+        recs[i] = {procs[i].pid, procs[i].arrival, procs[i].burst, procs[i].priority};
+    TraceHeader h = make_trace_header(TRACE_PROCESSES, recs.size(), sizeof(ProcessRecord));
+    return write_trace(path, h, recs.data(), recs.size() * sizeof(ProcessRecord));
+}
+
+bool write_gantt_binary(const string& path, const Schedule& sched){
+    vector<GanttRecord> recs;
+    for(size_t c=0;c<sched.cpu.size();c++)
+        for(auto &g: sched.cpu[c]) recs.push_back({(int32_t)c, g.pid, g.start, g.end});
+    TraceHeader h = make_trace_header(TRACE_GANTT, recs.size(), sizeof(GanttRecord));
+    h.cpus = sched.cpu.size();
+    strncpy(h.algorithm, sched.algorithm.c_str(), sizeof h.algorithm - 1);
+    for(size_t i=0;i<sched.params.size() && i<4;i++) h.params[i] = sched.params[i];
+    return write_trace(path, h, recs.data(), recs.size() * sizeof(GanttRecord));
+}
+
+void write_processes_text(ostream& out, const vector<Process>& procs){
+    bool policy = false, deadline = false;
+    for(auto &p: procs){
+        policy |= p.policy != 0;
+        deadline |= p.deadline || p.period;
+    }
+    out << procs.size() << "\n";
+    for(auto &p: procs){
+        out << p.pid << " " << p.arrival << " ";
+        if(p.bursts.empty()) out << p.burst;
+        for(size_t j=0;j<p.bursts.size();j++) out << (j ? "," : "") << p.bursts[j];
+        out << " " << p.priority;
+        if(policy) out << " " << p.policy;
+        if(deadline) out << " " << p.deadline << " " << p.period;
+        out << "\n";
+    }
+}
+
+int convert(const string& how, const string& in_path, const string& out_path, long long trace_unit_us){
+    InputBuffer in;
+    if(!in.open(in_path)) return 1;
+    if(how == "text2bin"){
+        vector<Process> procs;
+        if(!parse_processes(in.data, in.size, procs)) return 1;
+        return write_processes_binary(out_path, procs) ? 0 : 1;
+    }
+    if(how != "bin2text" && how != "trace2text"){
+        cerr << "convert: unknown conversion " << how << " (text2bin, bin2text, trace2text)\n";
+        return 1;
+    }
+    if(how == "trace2text"){
+        if(!is_sched_trace(in.data, in.size)){
+            cerr << "convert: " << in_path << " has no sched_switch events\n";
+            return 1;
+        }
+    } else if(!is_binary_trace(in.data, in.size)){
+        cerr << "convert: " << in_path << " is not a binary trace\n";
+        return 1;
+    }
+    const TraceHeader* peek = (const TraceHeader*)in.data;
+    ofstream file;
+    if(out_path != "-"){
+        file.open(out_path);
+        if(!file){
+            cerr << "cannot write " << out_path << ": " << strerror(errno) << "\n";
+            return 1;
+        }
+    }
+    ostream& out = out_path == "-" ? cout : file;
+    if(how == "trace2text"){
+        vector<Process> procs;
+        if(!load_sched_trace(in.data, in.size, procs, trace_unit_us)) return 1;
+        write_processes_text(out, procs);
+    } else if(peek->kind == TRACE_GANTT){
+        const TraceHeader* h = trace_header(in.data, in.size, TRACE_GANTT, sizeof(GanttRecord));
+        if(!h) return 1;
+        const GanttRecord* r = (const GanttRecord*)(in.data + sizeof(TraceHeader));
+        out << "# algorithm " << string(h->algorithm, strnlen(h->algorithm, sizeof h->algorithm))
+            << " params " << h->params[0] << " " << h->params[1] << " " << h->params[2] << " " << h->params[3]
+            << " cpus " << h->cpus << "\n";
+        out << h->count << "\n";
+        for(uint64_t i=0;i<h->count;i++)
+            out << r[i].cpu << " " << r[i].pid << " " << r[i].start << " " << r[i].end << "\n";
+    } else {
+        vector<Process> procs;
+        if(!load_processes_binary(in.data, in.size, procs)) return 1;
+        write_processes_text(out, procs);
+    }
+    out.flush();
+    if(!out){
+        cerr << "write error on " << out_path << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace schedsim
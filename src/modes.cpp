@@ -0,0 +1,421 @@
+// src/modes.cpp - one run per mode: admission order, simulation, results
+
+#include "schedsim/modes.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "schedsim/io.hpp"
+#include "schedsim/policies.hpp"
+
+namespace schedsim {
+using namespace std;
+
+void sort_by_arrival(vector<Process>& procs){
+    sort(procs.begin(), procs.end(), [](const Process& a, const Process& b){
+        if(a.arrival!=b.arrival) return a.arrival < b.arrival;
+        return a.pid < b.pid;
+    });
+}
+
+void sort_for_priority(vector<Process>& procs){
+    sort(procs.begin(), procs.end(), [](const Process& a, const Process& b){
+        if(a.arrival!=b.arrival) return a.arrival < b.arrival;
+        if(a.priority!=b.priority) return a.priority < b.priority;
+        return a.pid < b.pid;
+    });
+}
+
+Schedule run_round_robin(vector<Process>& procs, int quantum, const SmpConfig& smp,
+                         bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<RoundRobin> rqs(smp.cpus, RoundRobin(quantum));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.algorithm = "rr";
+    sched.params = {quantum};
+    return sched;
+}
+
+Schedule run_preemptive_priority(vector<Process>& procs, const SmpConfig& smp,
+                                 bool record_gantt){
+    sort_for_priority(procs);
+    ProcessTable t(procs);
+    vector<PriorityScheduler> rqs(smp.cpus, PriorityScheduler(t));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.algorithm = "pps";
+    return sched;
+}
+
+Schedule run_preemptive_priority_o1(vector<Process>& procs, const SmpConfig& smp,
+                                    bool record_gantt){
+    sort_for_priority(procs);
+    ProcessTable t(procs);
+    PriorityArray::Links links(t.n);
+    vector<PriorityArray> rqs(smp.cpus, PriorityArray(t, links));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.algorithm = "pps-o1";
+    return sched;
+}
+
+Schedule run_completely_fair(vector<Process>& procs, int sched_latency, int min_granularity,
+                             const SmpConfig& smp, bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<FairEntity> se = make_fair_entities(t);
+    vector<Cfs> rqs(smp.cpus, Cfs(se, sched_latency, min_granularity));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.algorithm = "cfs";
+    sched.params = {sched_latency, min_granularity};
+    return sched;
+}
+
+Schedule run_earliest_eligible_deadline(vector<Process>& procs, int max_slice, const SmpConfig& smp,
+                                        bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<FairEntity> se = make_fair_entities(t);
+    for(int i=0;i<t.n;i++) se[i].slice = max(1, min(t.burst[i], max_slice));
+    vector<Eevdf> rqs(smp.cpus, Eevdf(se));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.algorithm = "eevdf";
+    sched.params = {max_slice == INT_MAX ? 0 : max_slice};
+    return sched;
+}
+
+Schedule run_mixed(vector<Process>& procs, int rr_timeslice, int rt_runtime, int rt_period, int sched_latency,
+                   int min_granularity, const SmpConfig& smp, bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<int> policy(t.n), rt_level(t.n), rr_left(t.n);
+    for(int i=0;i<t.n;i++){
+        policy[i] = procs[i].policy;
+        if(policy[i] == ClassScheduler::OTHER) continue;
+        rt_level[i] = 99 - procs[i].priority; // kernel prio: 0 is the highest
+    }
+    PriorityArray::Links links(t.n);
+    vector<FairEntity> se = make_fair_entities(t);
+    vector<ClassScheduler> rqs(smp.cpus, ClassScheduler(rt_level.data(), links, se, policy, rr_left, rr_timeslice,
+                                                        rt_runtime, rt_period, sched_latency, min_granularity));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.classes.assign(3, ClassStats());
+    for(auto &p: procs){
+        ClassStats &c = sched.classes[p.policy];
+        c.processes++;
+        c.cpu_time += p.burst;
+        c.sum_wait += p.waiting_time;
+        c.max_wait = max<long long>(c.max_wait, p.waiting_time);
+        c.sum_tat += p.turnaround_time;
+    }
+    for(auto &rq: rqs) sched.rt_throttles += rq.throttles;
+    sched.algorithm = "mixed";
+    sched.params = {rr_timeslice, rt_runtime, rt_period};
+    return sched;
+}
+
+vector<int> make_tickets(const ProcessTable& t){
+    vector<int> tickets(t.n);
+    for(int i=0;i<t.n;i++) tickets[i] = nice_weight(t.priority[i]);
+    return tickets;
+}
+
+ShareStats share_stats(const vector<Process>& procs, int cpus){
+    int n = procs.size();
+    ShareStats f;
+    if(n == 0) return f;
+    vector<int> done(n);
+    iota(done.begin(), done.end(), 0);
+    sort(done.begin(), done.end(), [&](int a, int b){ return procs[a].completion_time < procs[b].completion_time; });
+    vector<long double> v_arrival(n);
+    long double v = 0, sum_abs = 0;
+    long long weight = 0;
+    int runnable = 0, last = 0;
+    f.min_lag = DBL_MAX;
+    f.max_lag = -DBL_MAX;
+    for(int a=0, d=0; d<n;){
+        bool arrive = a < n && procs[a].arrival <= procs[done[d]].completion_time;
+        int i = arrive ? a++ : done[d++];
+        int time = arrive ? procs[i].arrival : procs[i].completion_time;
+        if(weight) v += (long double)(time - last) * min(cpus, runnable) / weight;
+        last = time;
+        int w = nice_weight(procs[i].priority);
+        if(arrive){
+            v_arrival[i] = v;
+            weight += w;
+            runnable++;
+            continue;
+        }
+        weight -= w;
+        runnable--;
+        double lag = (double)(procs[i].burst - w * (v - v_arrival[i]));
+        sum_abs += fabs(lag);
+        f.min_lag = min(f.min_lag, lag);
+        f.max_lag = max(f.max_lag, lag);
+    }
+    f.processes = n;
+    f.mean_abs_lag = (double)(sum_abs / n);
+    return f;
+}
+
+Schedule run_lottery(vector<Process>& procs, int quantum, uint32_t seed, const SmpConfig& smp,
+                     bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<int> tickets = make_tickets(t);
+    vector<Lottery> rqs;
+    for(int c=0;c<smp.cpus;c++) rqs.emplace_back(tickets, quantum, (uint64_t)seed + c);
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.shares = share_stats(procs, smp.cpus);
+    sched.algorithm = "lottery";
+    sched.params = {quantum, (int)seed};
+    return sched;
+}
+
+Schedule run_stride(vector<Process>& procs, int quantum, const SmpConfig& smp, bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<int> tickets = make_tickets(t);
+    vector<long long> pass(t.n);
+    vector<Stride> rqs(smp.cpus, Stride(tickets, pass, quantum));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.shares = share_stats(procs, smp.cpus);
+    sched.algorithm = "stride";
+    sched.params = {quantum};
+    return sched;
+}
+
+Schedule run_shortest_remaining(vector<Process>& procs, bool preemptive, const SmpConfig& smp,
+                                bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<int> pos(t.n);
+    vector<ShortestRemaining> rqs(smp.cpus, ShortestRemaining(RemainingKey{&t}, preemptive, pos));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.algorithm = preemptive ? "srtf" : "sjf";
+    return sched;
+}
+
+vector<Process> release_jobs(vector<Process> tasks, int horizon, int cpus, DeadlineStats& ds){
+    sort_by_arrival(tasks);
+    ds.tasks = tasks.size();
+    ds.bound = DL_BW_LIMIT * cpus;
+    vector<Process> jobs;
+    for(auto &task: tasks){
+        int deadline = task.deadline ? task.deadline : task.period;
+        bool valid = (!deadline || task.burst <= deadline) && (!task.period || deadline <= task.period);
+        double bw = task.period ? (double)task.burst / task.period : 0;
+        if(!valid || ds.bandwidth + bw > ds.bound){
+            ds.rejected.push_back(task.pid);
+            continue;
+        }
+        ds.admitted++;
+        ds.bandwidth += bw;
+        long long release = task.arrival;
+        do {
+            Process job(task.pid, (int)release, task.burst, task.priority);
+            job.deadline = deadline;
+            job.period = task.period;
+            job.io_time = task.io_time;
+            job.bursts = task.bursts;
+            jobs.push_back(job);
+            release += task.period;
+        } while(task.period && release < horizon);
+    }
+    return jobs;
+}
+
+long long count_jobs(const vector<Process>& tasks, int horizon){
+    long long jobs = 0;
+    for(auto &task: tasks){
+        long long span = (long long)horizon - task.arrival;
+        jobs += task.period && span > 0 ? (span + task.period - 1) / task.period : 1;
+    }
+    return jobs;
+}
+
+Schedule run_earliest_deadline(vector<Process>& procs, int horizon, const SmpConfig& smp,
+                               bool record_gantt){
+    auto ds = make_unique<DeadlineStats>();
+    procs = release_jobs(procs, horizon, smp.cpus, *ds);
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    vector<uint32_t> deadline(t.n);
+    for(int i=0;i<t.n;i++)
+        deadline[i] = procs[i].deadline ? (uint32_t)min<long long>((long long)t.arrival[i] + procs[i].deadline,
+                                                                   UINT32_MAX - 1)
+                                        : UINT32_MAX;
+    vector<int> pos(t.n);
+    vector<EarliestDeadline> rqs(smp.cpus, EarliestDeadline(DeadlineKey{deadline.data()}, true, pos));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    for(int i=0;i<t.n;i++)
+        if(deadline[i] != UINT32_MAX) ds->job((long long)t.completion_time[i] - deadline[i]);
+    t.store(procs);
+    sched.deadlines = move(ds);
+    sched.algorithm = "edf";
+    sched.params = {horizon};
+    return sched;
+}
+
+Schedule run_multi_level_feedback(vector<Process>& procs, const vector<int>& quantum, int boost_interval,
+                                  const SmpConfig& smp, bool record_gantt){
+    sort_by_arrival(procs);
+    ProcessTable t(procs);
+    Mlfq::State st(t.n);
+    vector<Mlfq> rqs(smp.cpus, Mlfq(quantum, boost_interval, st));
+    Schedule sched = simulate(t, rqs, smp, record_gantt);
+    t.store(procs);
+    sched.levels = rqs[0].stats;
+    sched.boosts = rqs[0].epoch;
+    for(size_t c=1;c<rqs.size();c++){
+        for(size_t l=0;l<quantum.size();l++){
+            sched.levels[l].run_time += rqs[c].stats[l].run_time;
+            sched.levels[l].queued_time += rqs[c].stats[l].queued_time;
+            sched.levels[l].demotions += rqs[c].stats[l].demotions;
+        }
+        sched.boosts = max<long long>(sched.boosts, rqs[c].epoch);
+    }
+    sched.algorithm = "mlfq";
+    sched.params = {(int)quantum.size(), quantum[0], boost_interval};
+    return sched;
+}
+
+bool round_robin(vector<Process> procs, int quantum, const SmpConfig& smp,
+                 const OutputConfig& output){
+    Schedule sched = run_round_robin(procs, quantum, smp, output.needs_gantt());
+    return print_report("Round Robin (quantum = " + to_string(quantum) + ")", procs, sched, output);
+}
+
+bool preemptive_priority(vector<Process> procs, const SmpConfig& smp,
+                         const OutputConfig& output){
+    Schedule sched = run_preemptive_priority(procs, smp, output.needs_gantt());
+    return print_report("Preemptive Priority Scheduling (lower - higher priority)", procs, sched, output);
+}
+
+bool preemptive_priority_o1(vector<Process> procs, const SmpConfig& smp,
+                            const OutputConfig& output){
+    Schedule sched = run_preemptive_priority_o1(procs, smp, output.needs_gantt());
+    return print_report("Preemptive Priority Scheduling, O(1) priority array (lower - higher priority)",
+                 procs, sched, output);
+}
+
+bool completely_fair(vector<Process> procs, int sched_latency, int min_granularity,
+                     const SmpConfig& smp, const OutputConfig& output){
+    Schedule sched = run_completely_fair(procs, sched_latency, min_granularity, smp, output.needs_gantt());
+    return print_report("Completely Fair Scheduler (sched_latency = " + to_string(sched_latency)
+                 + ", min_granularity = " + to_string(min_granularity) + ")", procs, sched, output);
+}
+
+bool shortest_remaining(vector<Process> procs, bool preemptive, const SmpConfig& smp,
+                        const OutputConfig& output){
+    Schedule sched = run_shortest_remaining(procs, preemptive, smp, output.needs_gantt());
+    return print_report(preemptive ? "Shortest Remaining Time First" : "Shortest Job First (non-preemptive)",
+                 procs, sched, output);
+}
+
+bool mixed(vector<Process> procs, int rr_timeslice, int rt_runtime, int rt_period, int sched_latency,
+           int min_granularity, const SmpConfig& smp, const OutputConfig& output){
+    Schedule sched = run_mixed(procs, rr_timeslice, rt_runtime, rt_period, sched_latency, min_granularity, smp,
+                               output.needs_gantt());
+    return print_report("Mixed classes (rr_timeslice = " + to_string(rr_timeslice) + ", rt_runtime = "
+                 + (rt_runtime < 0 ? string("unlimited") : to_string(rt_runtime)) + " of rt_period = "
+                 + to_string(rt_period) + ", sched_latency = " + to_string(sched_latency)
+                 + ", min_granularity = " + to_string(min_granularity) + ")", procs, sched, output);
+}
+
+bool lottery(vector<Process> procs, int quantum, uint32_t seed, const SmpConfig& smp,
+             const OutputConfig& output){
+    Schedule sched = run_lottery(procs, quantum, seed, smp, output.needs_gantt());
+    return print_report("Lottery (quantum = " + to_string(quantum) + ", seed = " + to_string(seed) + ")",
+                 procs, sched, output);
+}
+
+bool stride(vector<Process> procs, int quantum, const SmpConfig& smp,
+            const OutputConfig& output){
+    Schedule sched = run_stride(procs, quantum, smp, output.needs_gantt());
+    return print_report("Stride (quantum = " + to_string(quantum) + ")", procs, sched, output);
+}
+
+bool earliest_deadline_first(vector<Process> procs, int horizon, const SmpConfig& smp,
+                             const OutputConfig& output){
+    Schedule sched = run_earliest_deadline(procs, horizon, smp, output.needs_gantt());
+    return print_report("Earliest Deadline First (horizon = " + to_string(horizon) + ")", procs, sched, output);
+}
+
+bool multi_level_feedback(vector<Process> procs, const vector<int>& quantum, int boost_interval,
+                          const SmpConfig& smp, const OutputConfig& output){
+    Schedule sched = run_multi_level_feedback(procs, quantum, boost_interval, smp, output.needs_gantt());
+    string qs;
+    for(size_t l=0;l<quantum.size();l++) qs += (l ? "/" : "") + to_string(quantum[l]);
+    return print_report("Multi-Level Feedback Queue (levels = " + to_string(quantum.size()) + ", quantum = " + qs
+                 + ", boost = " + (boost_interval ? to_string(boost_interval) : string("off")) + ")",
+                 procs, sched, output);
+}
+
+bool earliest_eligible_deadline(vector<Process> procs, int max_slice, const SmpConfig& smp,
+                                const OutputConfig& output){
+    Schedule sched = run_earliest_eligible_deadline(procs, max_slice, smp, output.needs_gantt());
+    return print_report("EEVDF (max_slice = " + (max_slice == INT_MAX ? string("burst") : to_string(max_slice)) + ")",
+                 procs, sched, output);
+}
+
+void sweep(const vector<Process>& procs, int qmin, int qmax, int qstep, int threads, const SmpConfig& smp){
+    struct Job { string label; int quantum; Metrics m; MetricsAccumulator stats; };
+    vector<Job> jobs;
+    for(long long q=qmin;q<=qmax;q+=qstep) jobs.push_back({"rr q=" + to_string(q), (int)q, {}, {}});
+    jobs.push_back({"pps", 0, {}, {}});
+
+    atomic<size_t> next_job(0);
+    auto worker = [&](){
+        for(size_t j; (j = next_job++) < jobs.size(); ){
+            vector<Process> copy = procs;
+            Schedule sched = jobs[j].quantum > 0 ? run_round_robin(copy, jobs[j].quantum, smp, false)
+                                                 : run_preemptive_priority(copy, smp, false);
+            jobs[j].m = compute_metrics(sched);
+            jobs[j].stats = move(sched.stats);
+        }
+    };
+    threads = max(1, min<int>(threads, jobs.size()));
+    vector<thread> pool;
+    for(int t=1;t<threads;t++) pool.emplace_back(worker);
+    worker();
+    for(auto &t: pool) t.join();
+
+    cout << "\n=== Parameter sweep (n = " << procs.size() << ", cpus = " << smp.cpus
+         << ", threads = " << threads << ") ===\n";
+    cout << "Config        AvgWaiting  AvgTurnaround  CtxSwitches  Throughput  P99Waiting  P99Response\n";
+    cout << fixed << setprecision(2);
+    for(auto &j: jobs){
+        cout << left << setw(12) << j.label << right << setw(12) << j.m.avg_wt << setw(15) << j.m.avg_tat
+             << setw(13) << j.m.context_switches << setw(12) << setprecision(4) << j.m.throughput
+             << setprecision(2) << setw(12) << j.m.wait.p99 << setw(13) << j.m.resp.p99 << "\n";
+    }
+    MetricsAccumulator rr;
+    for(auto &j: jobs) if(j.quantum > 0) rr.merge(j.stats);
+    Percentiles w = percentiles(rr.wait_hist), r = percentiles(rr.resp_hist);
+    cout << "RR, all quanta: waiting p50/p99/p99.9 " << w.p50 << " / " << w.p99 << " / " << w.p999
+         << ", response p50/p99/p99.9 " << r.p50 << " / " << r.p99 << " / " << r.p999 << "\n";
+}
+
+} // namespace schedsim
@@ -0,0 +1,191 @@
+// src/report.cpp - metrics and text output
+
+#include "schedsim/report.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "schedsim/io.hpp"
+
+namespace schedsim {
+using namespace std;
+
+void OutBuf::write_all(const char* s, size_t n){
+    size_t off = 0;
+    while(off < n){
+        ssize_t w = ::write(fd, s + off, n - off);
+        if(w < 0){
+            if(errno == EINTR) continue;
+            break; // closed pipe etc.: drop the rest
+        }
+        off += w;
+    }
+}
+
+void OutBuf::flush(){
+    write_all(buf.get(), len);
+    len = 0;
+}
+
+Percentiles percentiles(const Histogram& h){
+    Percentiles r;
+    r.p50 = h.percentile(50); r.p90 = h.percentile(90);
+    r.p99 = h.percentile(99); r.p999 = h.percentile(99.9);
+    r.max = h.max_value;
+    return r;
+}
+
+Metrics compute_metrics(const Schedule& sched){
+    const MetricsAccumulator &a = sched.stats;
+    Metrics m;
+    double n = a.completed;
+    int ncpu = a.busy.size();
+    int total_time = a.makespan;
+    m.makespan = total_time;
+    m.avg_wt = a.sum_wt/n;
+    m.avg_tat = a.sum_tat/n;
+    m.avg_io = a.sum_io/n;
+    long long total_busy = 0;
+    for(int c=0;c<ncpu;c++){
+        total_busy += a.busy[c];
+        m.idle_time += a.idle[c];
+        m.cpu_util_per_cpu.push_back(100.0 * a.busy[c] / (double) total_time);
+    }
+    m.cpu_util = 100.0 * total_busy / ((double) total_time * ncpu);
+    m.throughput = n / total_time;
+    m.context_switches = a.context_switches;
+    m.migrations = sched.migrations;
+    m.wait = percentiles(a.wait_hist);
+    m.tat = percentiles(a.tat_hist);
+    m.resp = percentiles(a.resp_hist);
+    return m;
+}
+
+void print_metrics(const Schedule& sched){
+    Metrics m = compute_metrics(sched);
+    int ncpu = m.cpu_util_per_cpu.size();
+    cout << fixed << setprecision(2);
+    cout << "\n--- Metrics ---\n";
+    cout << "Total time (makespan): " << m.makespan << "\n";
+    cout << "Average Waiting Time : " << m.avg_wt << "\n";
+    if(sched.stats.sum_io) cout << "Average I/O Wait Time : " << m.avg_io << "\n";
+    cout << "Average Turnaround Time : " << m.avg_tat << "\n";
+    const char* header = "Percentiles         p50       p90       p99     p99.9       max\n";
+    cout << header;
+    auto row = [](const char* name, const Percentiles& q){
+        cout << "  " << left << setw(12) << name << right << setw(9) << q.p50 << setw(10) << q.p90
+             << setw(10) << q.p99 << setw(10) << q.p999 << setw(10) << q.max << "\n";
+    };
+    row("Waiting", m.wait);
+    row("Turnaround", m.tat);
+    row("Response", m.resp);
+    cout << "CPU Utilization: " << m.cpu_util << " %\n";
+    if(ncpu > 1){
+        for(int c=0;c<ncpu;c++)
+            cout << "  CPU" << c << ": " << m.cpu_util_per_cpu[c] << " %\n";
+    }
+    cout << "Throughput (processes/unit time): " << m.throughput << "\n";
+    cout << "Context switches (approx): " << m.context_switches << "\n";
+    if(ncpu > 1) cout << "Migrations: " << m.migrations << "\n";
+    if(!sched.levels.empty()){
+        cout << "MLFQ level  Quantum  RunTime  AvgQueued  Demotions\n";
+        for(size_t l=0;l<sched.levels.size();l++){
+            const LevelStats &s = sched.levels[l];
+            cout << setw(10) << l << setw(9) << s.quantum << setw(9) << s.run_time
+                 << setw(11) << (m.makespan ? (double)s.queued_time / m.makespan : 0.0)
+                 << setw(11) << s.demotions << "\n";
+        }
+        cout << "Priority boosts: " << sched.boosts << "\n";
+    }
+    if(!sched.classes.empty()){
+        static const char* name[] = {"SCHED_OTHER", "SCHED_FIFO", "SCHED_RR"};
+        cout << "Class        Procs  CpuTime  AvgWait  MaxWait  AvgTurnaround\n";
+        for(size_t c=0;c<sched.classes.size();c++){
+            const ClassStats &s = sched.classes[c];
+            if(!s.processes) continue;
+            cout << left << setw(11) << name[c] << right << setw(7) << s.processes << setw(9) << s.cpu_time
+                 << setw(9) << (double)s.sum_wait / s.processes << setw(9) << s.max_wait
+                 << setw(15) << (double)s.sum_tat / s.processes << "\n";
+        }
+        cout << "RT throttled: " << sched.rt_throttles << " periods\n";
+    }
+    if(sched.shares.processes){
+        const ShareStats &f = sched.shares;
+        cout << "Lag vs ticket share: mean |lag| " << f.mean_abs_lag << ", min " << f.min_lag
+             << ", max " << f.max_lag << "\n";
+    }
+    if(sched.deadlines){
+        const DeadlineStats &d = *sched.deadlines;
+        cout << "Admitted tasks: " << d.admitted << " of " << d.tasks << " (bandwidth " << d.bandwidth
+             << " of " << d.bound << ")\n";
+        if(!d.rejected.empty()){
+            cout << "Rejected:";
+            for(int pid: d.rejected) cout << " P" << pid;
+            cout << "\n";
+        }
+        cout << "Deadline misses: " << d.misses << " of " << d.jobs << " jobs ("
+             << (d.jobs ? 100.0 * d.misses / d.jobs : 0.0) << " %)\n";
+        if(d.jobs){
+            cout << "Lateness: mean " << (double)d.sum_lateness / d.jobs << ", min " << d.min_lateness
+                 << ", max " << d.max_lateness << "\n";
+            cout << header;
+            row("Tardiness", percentiles(d.tardiness));
+        }
+    }
+}
+
+OutBuf& stdout_buf(){
+    static OutBuf out(1);
+    return out;
+}
+
+void print_gantt(const Schedule& sched){
+    OutBuf& out = stdout_buf();
+    out.begin();
+    out.put("\nGantt Chart (pid : [start -> end])\n");
+    for(size_t c=0;c<sched.cpu.size();c++){
+        if(sched.cpu.size() > 1){ out.put("CPU"); out.put_int(c); out.put(": "); }
+        for(auto &g: sched.cpu[c]){
+            if(g.pid == -1) out.put("idle");
+            else { out.put('P'); out.put_int(g.pid); }
+            out.put(" : ["); out.put_int(g.start); out.put(" -> "); out.put_int(g.end); out.put("]  ");
+        }
+        out.put('\n');
+    }
+    out.flush();
+}
+
+void put_table_row(OutBuf& out, const Process& p){
+    out.put_int(p.pid, 3); out.put_int(p.arrival, 9); out.put_int(p.burst, 7);
+    out.put_int(p.priority, 9); out.put_int(p.start_time, 7); out.put_int(p.completion_time, 11);
+    out.put_int(p.waiting_time, 9); out.put_int(p.turnaround_time, 11); out.put('\n');
+}
+
+void print_table(const vector<Process>& procs){
+    OutBuf& out = stdout_buf();
+    out.begin();
+    out.put(TABLE_HEADER);
+    for(auto &p: procs) put_table_row(out, p);
+    out.flush();
+}
+
+bool print_report(const string& title, const vector<Process>& procs, const Schedule& sched,
+                  const OutputConfig& output){
+    if(!output.quiet){
+        cout << "\n=== " << title << " ===\n";
+        if(!output.metrics_only) print_gantt(sched);
+        print_metrics(sched);
+        if(!output.metrics_only) print_table(procs);
+        cout.flush();
+    }
+    return output.gantt_out.empty() || write_gantt_binary(output.gantt_out, sched);
+}
+
+} // namespace schedsim
@@ -0,0 +1,180 @@
+// src/stream.cpp - bounded-memory simulation of an arrival stream
+
+#include "schedsim/stream.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "schedsim/io.hpp"
+#include "schedsim/modes.hpp"
+#include "schedsim/policies.hpp"
+
+namespace schedsim {
+using namespace std;
+
+// Arrivals read from a ProcessReader as simulated time reaches them. The
+// processes sharing an arrival time are read as one batch and sorted into
+// the mode's admission order; each is admitted into a free table row (then
+// on_admit(i) sets up the policy's per-row state) and on completion handed
+// to on_retire(i) before the row is freed.
+template<class OnAdmit, class OnRetire>
+struct StreamArrivals {
+    ProcessReader& in;
+    ProcessTable& t;
+    bool by_priority;   // PPS admission order within a batch
+    OnAdmit on_admit;
+    OnRetire on_retire;
+    int min_priority = INT_MIN, max_priority = INT_MAX;
+    vector<Process> batch;
+    size_t pos = 0;
+    Process ahead;              // first process of the next batch
+    bool have_ahead = false;
+    bool stopped = false;       // input error or table overflow
+    int peak_live = 0;
+
+    StreamArrivals(ProcessReader& in, ProcessTable& t, bool by_priority, OnAdmit on_admit, OnRetire on_retire)
+        :in(in), t(t), by_priority(by_priority), on_admit(on_admit), on_retire(on_retire){}
+
+    void read_batch(){
+        batch.clear();
+        pos = 0;
+        if(!have_ahead && !in.next(ahead)) return;
+        batch.push_back(ahead);
+        while((have_ahead = in.next(ahead)) && ahead.arrival == batch[0].arrival) batch.push_back(ahead);
+        if(by_priority) sort_for_priority(batch);
+        else sort_by_arrival(batch);
+    }
+
+    void stop(const string& msg){
+        cerr << msg << "\n";
+        stopped = true;
+    }
+
+    int next_arrival(){
+        if(stopped) return INT_MAX;
+        if(pos == batch.size()) read_batch();
+        if(pos == batch.size()) return INT_MAX;
+        const Process &p = batch[pos];
+        if(p.priority < min_priority || p.priority > max_priority){
+            stop("priority of P" + to_string(p.pid) + " outside " + to_string(min_priority) + ".."
+                 + to_string(max_priority));
+            return INT_MAX;
+        }
+        if(t.full()){
+            stop("more than " + to_string(t.n) + " live processes at time " + to_string(p.arrival)
+                 + " (raise --max-live)");
+            return INT_MAX;
+        }
+        return p.arrival;
+    }
+
+    int admit(){
+        int i = t.admit(batch[pos++]);
+        on_admit(i);
+        peak_live = max(peak_live, t.live());
+        return i;
+    }
+
+    void retire(int i){
+        on_retire(i);
+        t.retire(i);
+    }
+
+    bool ok() const { return !stopped && !in.failed; }
+};
+
+// Simulate one policy over the stream: per-process rows are written in
+// completion order as processes retire, metrics come from the run's
+// accumulator, and nothing else is kept.
+template<class Sched, class OnAdmit>
+bool stream_policy(ProcessReader& in, ProcessTable& t, vector<Sched>& rqs, bool by_priority, OnAdmit on_admit,
+                   const SmpConfig& smp, const OutputConfig& output, int max_priority = INT_MAX){
+    bool rows = !output.quiet && !output.metrics_only;
+    OutBuf& out = stdout_buf();
+    if(rows){ out.begin(); out.put(TABLE_HEADER); }
+    auto on_retire = [&](int i){ if(rows) put_table_row(out, t.get(i)); };
+    StreamArrivals<OnAdmit, decltype(on_retire)> arrivals(in, t, by_priority, on_admit, on_retire);
+    if(max_priority != INT_MAX){ arrivals.min_priority = 0; arrivals.max_priority = max_priority; }
+    Schedule sched = simulate(t, arrivals, rqs, smp, false);
+    if(rows) out.flush();
+    if(!output.quiet){
+        print_metrics(sched);
+        cout << "Processes completed: " << sched.stats.completed << "\n";
+        cout << "Peak live processes: " << arrivals.peak_live << " (table capacity " << t.n << ")\n";
+        cout.flush();
+    }
+    return arrivals.ok();
+}
+
+int stream(const vector<string>& args, const string& input_path, int max_live, const SmpConfig& smp,
+           const OutputConfig& output){
+    string mode = args.size() >= 2 ? args[1] : "";
+    if(mode != "rr" && mode != "pps" && mode != "cfs" && mode != "eevdf"){
+        cerr << "usage: stream rr [quantum] | pps | cfs [sched_latency] [min_granularity] | eevdf [max_slice]\n";
+        return 1;
+    }
+    // every mode argument is an int, checked here so arg() can use stoi
+    for(size_t i=2;i<args.size();i++){
+        long long v;
+        if(!parse_int(args[i], v) || v < INT_MIN || v > INT_MAX){
+            cerr << "stream " << mode << ": expected an integer, got " << args[i] << "\n";
+            return 1;
+        }
+    }
+    auto arg = [&](size_t i, int def){ return args.size() > i ? stoi(args[i]) : def; };
+    string title;
+    if(mode == "rr") title = "Round Robin (quantum = " + to_string(arg(2, 2)) + ")";
+    else if(mode == "pps") title = "Preemptive Priority Scheduling (lower - higher priority)";
+    else if(mode == "cfs") title = "Completely Fair Scheduler (sched_latency = " + to_string(arg(2, 6))
+                                   + ", min_granularity = " + to_string(arg(3, 1)) + ")";
+    else title = "EEVDF (max_slice = " + (args.size() > 2 ? args[2] : string("burst")) + ")";
+    if(!output.gantt_out.empty()){
+        cerr << "stream: --gantt-out is not available, no timeline is kept\n";
+        return 1;
+    }
+    ProcessReader in;
+    if(!in.open(input_path)) return 1;
+    if(!output.quiet) cout << "\n=== Stream: " << title << " ===\n";
+
+    ProcessTable t(max_live);
+    auto no_setup = [](int){};
+    bool ok;
+    if(mode == "rr"){
+        int quantum = arg(2, 2);
+        if(quantum < 1){ cerr << "stream rr: quantum must be positive\n"; return 1; }
+        vector<RoundRobin> rqs(smp.cpus, RoundRobin(quantum));
+        ok = stream_policy(in, t, rqs, false, no_setup, smp, output);
+    } else if(mode == "pps"){
+        PriorityArray::Links links(t.n);
+        vector<PriorityArray> rqs(smp.cpus, PriorityArray(t, links));
+        ok = stream_policy(in, t, rqs, true, no_setup, smp, output, PriorityArray::MAX_PRIO - 1);
+    } else if(mode == "cfs"){
+        int sched_latency = arg(2, 6), min_granularity = arg(3, 1);
+        if(sched_latency < 1 || min_granularity < 1){
+            cerr << "stream cfs: sched_latency and min_granularity must be positive\n";
+            return 1;
+        }
+        vector<FairEntity> se(t.n);
+        auto setup = [&](int i){ se[i] = FairEntity(); se[i].weight = nice_weight(t.priority[i]); };
+        vector<Cfs> rqs(smp.cpus, Cfs(se, sched_latency, min_granularity));
+        ok = stream_policy(in, t, rqs, false, setup, smp, output);
+    } else {
+        int max_slice = arg(2, INT_MAX);
+        if(max_slice < 1){ cerr << "stream eevdf: max_slice must be positive\n"; return 1; }
+        vector<FairEntity> se(t.n);
+        auto setup = [&](int i){
+            se[i] = FairEntity();
+            se[i].weight = nice_weight(t.priority[i]);
+            se[i].slice = max(1, min(t.burst[i], max_slice));
+        };
+        vector<Eevdf> rqs(smp.cpus, Eevdf(se));
+        ok = stream_policy(in, t, rqs, false, setup, smp, output);
+    }
+    return ok ? 0 : 1;
+}
+
+} // namespace schedsim